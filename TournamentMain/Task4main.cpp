@@ -1,9 +1,10 @@
 
 #include <iostream>
 #include "game_result.hpp"
+#include "task_entry_points.hpp"
 using namespace std;
 
-MatchResult matchLog[100];
+MatchResult matchLog[MAX_MATCH_RESULTS];
 int matchCount = 0;
 
 void Task4Main() {
@@ -31,3 +32,43 @@ void Task4Main() {
 
     
 }
+
+// Batch commands: record-result (saved to results.txt straight away, as there is no
+// menu exit to save on), list-results, history
+BatchStatus Task4BatchCommand(const string& command, istringstream& args) {
+    static bool loaded = false;
+    if (command != "record-result" && command != "list-results" && command != "history") {
+        return BATCH_UNKNOWN;
+    }
+    if (!loaded) {
+        loadResultsFromFile(matchLog, matchCount, "results.txt");
+        loaded = true;
+    }
+
+    if (command == "record-result") {
+        string matchID, player1, player2;
+        int score1, score2;
+        if (!(args >> matchID >> player1 >> player2 >> score1 >> score2)) {
+            cerr << "Usage: record-result <match id> <player 1> <player 2> <score 1> <score 2>" << endl;
+            return BATCH_FAILED;
+        }
+        if (!recordMatchResult(matchLog, matchCount, matchID.c_str(), player1.c_str(), player2.c_str(), score1, score2)) {
+            return BATCH_FAILED;
+        }
+        saveResultsToFile(matchLog, matchCount, "results.txt");
+    }
+    else if (command == "list-results") {
+        displayResults(matchLog, matchCount);
+    }
+    else {
+        string playerName;
+        getline(args, playerName);
+        playerName.erase(0, playerName.find_first_not_of(" \t"));
+        if (playerName.empty()) {
+            cerr << "Usage: history <player name>" << endl;
+            return BATCH_FAILED;
+        }
+        searchPlayerHistory(matchLog, matchCount, playerName.c_str());
+    }
+    return BATCH_DONE;
+}
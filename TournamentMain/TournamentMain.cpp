@@ -3,17 +3,23 @@
 #include "bracket.hpp"
 #include "match_scheduling.hpp"
 #include "task_entry_points.hpp"
+#include "registration_journal.hpp" // Dropped when the dummy roster replaces players.txt
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <sstream>
 #include <limits>   // Required for numeric_limits
 #include <cstdlib>  // Required for system() function
+#include <cstring>  // For strcmp
 
 // Function to clear the console screen
 
 
 // Function to create a dummy players.txt file for initial testing
 void createDummyPlayersFile(const char* filename) {
+    if (strcmp(filename, registrationJournal().getSnapshotFilename()) == 0) {
+        registrationJournal().discard(); // Registration events no longer apply to the new roster
+    }
     std::ofstream file(filename);
     if (file.is_open()) {
         file << "1,Alice,2025-01-01 10:00:00,Registered,10\n";
@@ -80,6 +86,10 @@ void displayMenu() {
     std::cout << "10. Run Knockout Stage Simulation" << std::endl;
     std::cout << "11. Output Current Standings to File" << std::endl;
     std::cout << "12. Output Scheduled Matches to File" << std::endl;
+    std::cout << "13. Display Group Standings" << std::endl;
+    std::cout << "14. Plan Match Day (Stations & Time Slots)" << std::endl;
+    std::cout << "15. Run Monte Carlo Outcome Simulation" << std::endl;
+    std::cout << "16. Generate Next Swiss Round" << std::endl;
     std::cout << "0. Exit" << std::endl;
     std::cout << "Enter your choice: ";
 }
@@ -91,9 +101,12 @@ void Task1Main(){
     const char* resultsFile = "results.txt";
     const char* standingsFile = "current_standings.txt";
     const char* scheduledMatchesFile = "scheduled_matches.txt";
+    const char* matchDayPlanFile = "match_day_plan.txt";
+    const char* simulationReportFile = "simulation_report.txt";
 
-    // Ensure results file is clear at the start
+    // Ensure results file is clear at the start, and start ingesting it from scratch
     clearResultsFile(resultsFile);
+    scheduler.resetResultCheckpoint(resultsFile);
     clearScreen(); // Clear screen at program start
 
     do {
@@ -119,9 +132,17 @@ void Task1Main(){
             case 3:
                 scheduler.displayAllPlayers();
                 break;
-            case 4:
-                scheduler.generateGroupStageMatches();
+            case 4: {
+                int numGroups;
+                std::cout << "Enter number of groups: ";
+                std::cin >> numGroups;
+                if (std::cin.fail() || numGroups < 1) {
+                    std::cin.clear();
+                    numGroups = 1; // Fall back to a single group
+                }
+                scheduler.generateGroupStageMatches(numGroups);
                 break;
+            }
             case 5:
                 scheduler.displayGroupStageQueue();
                 break;
@@ -141,9 +162,17 @@ void Task1Main(){
                 clearResultsFile(resultsFile); // Clear previous results to ensure full simulation processes unplayed matches
                 scheduler.runGroupStageSimulation();
                 break;
-            case 8:
-                scheduler.generateKnockoutStageBracket();
+            case 8: {
+                int knockoutSize;
+                std::cout << "Enter number of knockout qualifiers: ";
+                std::cin >> knockoutSize;
+                if (std::cin.fail() || knockoutSize < 2) {
+                    std::cin.clear();
+                    knockoutSize = 8; // Fall back to the usual top 8
+                }
+                scheduler.generateKnockoutStageBracket(knockoutSize);
                 break;
+            }
             case 9:
                 scheduler.displayKnockoutBracket();
                 break;
@@ -156,6 +185,41 @@ void Task1Main(){
             case 12:
                 scheduler.outputScheduledMatches(scheduledMatchesFile);
                 break;
+            case 13:
+                scheduler.displayGroupStandings();
+                break;
+            case 14: {
+                int stationCount, maxSlots;
+                std::cout << "Enter number of game stations: ";
+                std::cin >> stationCount;
+                std::cout << "Enter maximum number of time slots (0 for no limit): ";
+                std::cin >> maxSlots;
+                if (std::cin.fail()) {
+                    std::cin.clear();
+                    std::cout << "Invalid input." << std::endl;
+                    break;
+                }
+                scheduler.planMatchDay(stationCount, maxSlots, matchDayPlanFile);
+                break;
+            }
+            case 15: {
+                long long tournamentCount;
+                int knockoutSize;
+                std::cout << "Enter number of tournaments to simulate: ";
+                std::cin >> tournamentCount;
+                std::cout << "Enter number of knockout qualifiers: ";
+                std::cin >> knockoutSize;
+                if (std::cin.fail() || tournamentCount < 1) {
+                    std::cin.clear();
+                    std::cout << "Invalid input." << std::endl;
+                    break;
+                }
+                scheduler.runMonteCarloSimulation(tournamentCount, knockoutSize, simulationReportFile);
+                break;
+            }
+            case 16:
+                scheduler.generateSwissRound();
+                break;
             case 0:
                 std::cout << "Exiting Tournament Management System. Goodbye!" << std::endl;
                 break;
@@ -175,4 +239,109 @@ void Task1Main(){
     } while (choice != 0);
 
    
-}
\ No newline at end of file
+}
+
+// Scheduler shared by the batch commands; like Task1Main it starts from an empty results file
+MatchScheduler& batchScheduler() {
+    static MatchScheduler scheduler;
+    static bool started = false;
+    if (!started) {
+        clearResultsFile("results.txt");
+        scheduler.resetResultCheckpoint("results.txt");
+        started = true;
+    }
+    return scheduler;
+}
+
+// Batch commands: dummy-players, load-players, players, gen-groups, group-queue, result,
+// simulate-groups, gen-knockout, bracket, simulate-knockout, standings, schedule,
+// group-standings, plan, montecarlo, swiss
+BatchStatus Task1BatchCommand(const std::string& command, std::istringstream& args) {
+    if (command == "dummy-players") {
+        createDummyPlayersFile("players.txt");
+        return BATCH_DONE;
+    }
+    if (command == "load-players") {
+        std::string filename = "players.txt";
+        args >> filename;
+        batchScheduler().loadPlayersFromFile(filename.c_str());
+    }
+    else if (command == "players") {
+        batchScheduler().displayAllPlayers();
+    }
+    else if (command == "gen-groups") {
+        int numGroups = 1;
+        if (args >> numGroups && numGroups < 1) {
+            numGroups = 1; // Same fallback as the menu
+        }
+        batchScheduler().generateGroupStageMatches(numGroups);
+    }
+    else if (command == "group-queue") {
+        batchScheduler().displayGroupStageQueue();
+    }
+    else if (command == "result") {
+        int matchID, winnerID;
+        if (!(args >> matchID >> winnerID)) {
+            std::cerr << "Usage: result <match id> <winner id>" << std::endl;
+            return BATCH_FAILED;
+        }
+        return batchScheduler().submitMatchResult("results.txt", matchID, winnerID) ? BATCH_DONE : BATCH_FAILED;
+    }
+    else if (command == "simulate-groups") {
+        MatchScheduler& scheduler = batchScheduler();
+        clearResultsFile("results.txt");
+        scheduler.runGroupStageSimulation();
+    }
+    else if (command == "gen-knockout") {
+        int knockoutSize = 8;
+        if (args >> knockoutSize && knockoutSize < 2) {
+            knockoutSize = 8;
+        }
+        batchScheduler().generateKnockoutStageBracket(knockoutSize);
+    }
+    else if (command == "bracket") {
+        batchScheduler().displayKnockoutBracket();
+    }
+    else if (command == "simulate-knockout") {
+        batchScheduler().runKnockoutStageSimulation();
+    }
+    else if (command == "standings") {
+        std::string filename = "current_standings.txt";
+        args >> filename;
+        batchScheduler().outputCurrentStandings(filename.c_str());
+    }
+    else if (command == "schedule") {
+        std::string filename = "scheduled_matches.txt";
+        args >> filename;
+        batchScheduler().outputScheduledMatches(filename.c_str());
+    }
+    else if (command == "group-standings") {
+        batchScheduler().displayGroupStandings();
+    }
+    else if (command == "plan") {
+        int stationCount, maxSlots = 0;
+        if (!(args >> stationCount)) {
+            std::cerr << "Usage: plan <stations> [max slots]" << std::endl;
+            return BATCH_FAILED;
+        }
+        args >> maxSlots;
+        batchScheduler().planMatchDay(stationCount, maxSlots, "match_day_plan.txt");
+    }
+    else if (command == "montecarlo") {
+        long long tournamentCount;
+        int knockoutSize = 8;
+        if (!(args >> tournamentCount) || tournamentCount < 1) {
+            std::cerr << "Usage: montecarlo <tournaments> [knockout size]" << std::endl;
+            return BATCH_FAILED;
+        }
+        args >> knockoutSize;
+        batchScheduler().runMonteCarloSimulation(tournamentCount, knockoutSize, "simulation_report.txt");
+    }
+    else if (command == "swiss") {
+        batchScheduler().generateSwissRound();
+    }
+    else {
+        return BATCH_UNKNOWN;
+    }
+    return BATCH_DONE;
+}
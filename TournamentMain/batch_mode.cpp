@@ -0,0 +1,83 @@
+#include "batch_mode.hpp"
+#include "task_entry_points.hpp"
+#include "perf_stats.hpp"
+#include <iostream>
+#include <sstream>
+#include <string>
+
+typedef BatchStatus (*BatchHandler)(const std::string& command, std::istringstream& args);
+
+// "stats" prints the latency histograms and counters; "stats reset|on|off" clears them
+// or switches recording
+BatchStatus StatsBatchCommand(const std::string& command, std::istringstream& args) {
+    if (command != "stats") return BATCH_UNKNOWN;
+
+    std::string action;
+    args >> action;
+    if (action.empty()) {
+        printPerfStats(std::cout);
+    }
+    else if (action == "reset") {
+        resetPerfStats();
+        std::cout << "Performance statistics cleared." << std::endl;
+    }
+    else if (action == "on" || action == "off") {
+        perfStatsEnabled = action == "on";
+        std::cout << "Performance recording " << action << "." << std::endl;
+    }
+    else {
+        std::cerr << "Usage: stats [reset|on|off]" << std::endl;
+        return BATCH_FAILED;
+    }
+    return BATCH_DONE;
+}
+
+// Every task's command handler; a command goes to the first one that knows it
+const BatchHandler batchHandlers[] = {
+    Task1BatchCommand, // Scheduling: load-players, gen-groups, result, gen-knockout, ...
+    Task2BatchCommand, // Registration: register, checkin, withdraw, replace, import-players, ...
+    Task3BatchCommand, // Spectators: add-spectator, remove-spectator, assign-seat, ...
+    Task4BatchCommand, // Result log: record-result, list-results, history
+    StatsBatchCommand  // Instrumentation: stats
+};
+
+int runBatchMode(std::istream& script) {
+    std::string line;
+    int lineNumber = 0;
+    int commandCount = 0;
+    int failures = 0;
+
+    while (std::getline(script, line)) {
+        lineNumber++;
+        if (!line.empty() && line[line.size() - 1] == '\r') {
+            line.erase(line.size() - 1); // Scripts saved with Windows line endings
+        }
+        std::istringstream args(line);
+        std::string command;
+        if (!(args >> command) || command[0] == '#') {
+            continue;
+        }
+        if (command == "quit" || command == "exit") {
+            break;
+        }
+
+        std::cout << "> " << line << std::endl; // Echo so the output log reads as a transcript
+        commandCount++;
+        BatchStatus status = BATCH_UNKNOWN;
+        for (size_t i = 0; i < sizeof(batchHandlers) / sizeof(batchHandlers[0]) && status == BATCH_UNKNOWN; ++i) {
+            status = batchHandlers[i](command, args);
+        }
+
+        if (status == BATCH_UNKNOWN) {
+            std::cerr << "Line " << lineNumber << ": unknown command '" << command << "'" << std::endl;
+            failures++;
+        }
+        else if (status == BATCH_FAILED) {
+            std::cerr << "Line " << lineNumber << ": '" << command << "' failed" << std::endl;
+            failures++;
+        }
+    }
+
+    std::cout << "Batch finished: " << commandCount << " commands, " << failures << " failed." << std::endl;
+    return failures;
+}
@@ -0,0 +1,12 @@
+#ifndef BATCH_MODE_HPP
+#define BATCH_MODE_HPP
+
+#include <istream>
+
+// Headless command mode: runs a script of commands (one per line, arguments separated
+// by spaces) against all four tasks with no prompts, pauses or screen clears. Blank
+// lines and lines starting with '#' are skipped; "quit" ends the script early.
+// Returns the number of commands that were unknown or failed.
+int runBatchMode(std::istream& script);
+
+#endif // BATCH_MODE_HPP
@@ -0,0 +1,371 @@
+// benchmarks.cpp - Microbenchmarks for the core containers (a separate program with its own main).
+// Build it with the "benchmarks" CMake target (see BENCHMARK_SOURCES for its files).
+// Usage: benchmarks [--max N] [--lookups N]
+// Sizes run from 1k up to --max (default 1M) in steps of 10x. The report is CSV on stdout:
+//   structure,operation,size,ops,ns_per_op,allocs_per_op
+#include "benchmarks.hpp"
+#include "player.hpp"
+#include "match.hpp"
+#include "bracket.hpp"
+#include "spectator_queue.hpp"
+#include "tournament_registration.hpp"
+#include "perf_stats.hpp"
+#include <cstdlib>   // For malloc/free and atoi
+#include <cstring>   // For strcmp
+#include <new>       // For std::bad_alloc
+#include <random>
+#include <vector>
+#include <algorithm> // For std::shuffle
+#include <cstdio>    // For snprintf
+
+long long benchmarkAllocations = 0;
+std::ostream* benchmarkReport = nullptr;
+long long benchmarkSink = 0;
+
+// Counting replacements of the global allocation functions (this program is single-threaded)
+void* operator new(std::size_t size) {
+    benchmarkAllocations++;
+    void* memory = std::malloc(size != 0 ? size : 1);
+    if (memory == nullptr) throw std::bad_alloc();
+    return memory;
+}
+void* operator new[](std::size_t size) {
+    benchmarkAllocations++;
+    void* memory = std::malloc(size != 0 ? size : 1);
+    if (memory == nullptr) throw std::bad_alloc();
+    return memory;
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+// The registration module pauses through clearScreen(); none of that runs here
+void clearScreen() {}
+
+// Swallows everything written to it
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+// IDs 1..size in random order, for lookups that do not walk memory sequentially
+std::vector<int> shuffledIDs(int size, std::mt19937& rng) {
+    std::vector<int> ids(static_cast<size_t>(size));
+    for (int i = 0; i < size; ++i) ids[i] = i + 1;
+    std::shuffle(ids.begin(), ids.end(), rng);
+    return ids;
+}
+
+void benchmarkPlayerList(int size, std::mt19937& rng) {
+    std::uniform_int_distribution<int> priorityDist(1, 10);
+    const std::int64_t regTime = parseRegistrationTime("2025-01-01 10:00:00");
+    PlayerList* players = new PlayerList();
+    {
+        BenchmarkTimer timer("PlayerList", "insert", size);
+        for (int i = 0; i < size; ++i) {
+            players->addPlayer(new Player(i + 1, "Player Name", regTime, STATUS_REGISTERED, priorityDist(rng)));
+        }
+        timer.finish(size);
+    }
+
+    std::vector<int> ids = shuffledIDs(size, rng);
+    {
+        BenchmarkTimer timer("PlayerList", "lookup", size);
+        for (int i = 0; i < size; ++i) {
+            benchmarkSink += players->getPlayerByID(ids[i])->priority;
+        }
+        timer.finish(size);
+    }
+
+    std::uniform_int_distribution<int> recordDist(0, 6);
+    for (Player* current = players->head; current != nullptr; current = current->next) {
+        current->wins = recordDist(rng);
+        current->losses = recordDist(rng);
+    }
+    {
+        BenchmarkTimer timer("PlayerList", "sort", size);
+        players->sortPlayersByRanking();
+        timer.finish(size);
+    }
+
+    {
+        BenchmarkTimer timer("PlayerList", "traverse", size);
+        for (Player* current = players->head; current != nullptr; current = current->next) {
+            benchmarkSink += current->wins;
+        }
+        timer.finish(size);
+    }
+
+    {
+        // The list only releases its players all at once
+        BenchmarkTimer timer("PlayerList", "remove", size);
+        delete players;
+        timer.finish(size);
+    }
+}
+
+void benchmarkMatchQueue(int size, std::mt19937& rng) {
+    MatchQueue queue;
+    {
+        BenchmarkTimer timer("MatchQueue", "insert", size);
+        for (int i = 0; i < size; ++i) {
+            queue.enqueue(queue.createMatch(i + 1, 2 * i + 1, 2 * i + 2));
+        }
+        timer.finish(size);
+    }
+
+    std::vector<int> ids = shuffledIDs(size, rng);
+    {
+        BenchmarkTimer timer("MatchQueue", "lookup", size);
+        for (int i = 0; i < size; ++i) {
+            benchmarkSink += queue.getMatchByID(ids[i])->player1ID;
+        }
+        timer.finish(size);
+    }
+
+    {
+        BenchmarkTimer timer("MatchQueue", "traverse", size);
+        Match* current = queue.front;
+        do {
+            benchmarkSink += current->player2ID;
+            current = current->next;
+        } while (current != queue.front);
+        timer.finish(size);
+    }
+
+    {
+        BenchmarkTimer timer("MatchQueue", "remove", size);
+        while (!queue.isEmpty()) {
+            benchmarkSink += queue.dequeue()->matchID;
+        }
+        timer.finish(size);
+    }
+}
+
+void benchmarkBracket(int size, std::mt19937& rng) {
+    std::vector<int> seededIDs(static_cast<size_t>(size));
+    for (int i = 0; i < size; ++i) seededIDs[i] = i + 1;
+
+    TournamentBracket bracket;
+    {
+        BenchmarkTimer timer("TournamentBracket", "insert", size); // Builds the whole seeded bracket
+        bracket.buildBracket(seededIDs);
+        timer.finish(size);
+    }
+
+    std::uniform_int_distribution<int> slotDist(1, bracket.leafCount - 1);
+    std::vector<int> matchIDs(static_cast<size_t>(size));
+    for (int i = 0; i < size; ++i) matchIDs[i] = bracket.matchIDOfSlot(slotDist(rng));
+    {
+        BenchmarkTimer timer("TournamentBracket", "lookup", size);
+        for (int i = 0; i < size; ++i) {
+            benchmarkSink += bracket.nodes[bracket.slotOfMatch(matchIDs[i])].player1ID;
+        }
+        timer.finish(size);
+    }
+
+    {
+        BenchmarkTimer timer("TournamentBracket", "traverse", size);
+        for (size_t slot = 1; slot < bracket.nodes.size(); ++slot) {
+            benchmarkSink += bracket.nodes[slot].winnerID;
+        }
+        timer.finish(static_cast<long long>(bracket.nodes.size()) - 1);
+    }
+
+    {
+        // Decides every match through the ready queue (each result removes one player)
+        long long played = 0;
+        BenchmarkTimer timer("TournamentBracket", "remove", size);
+        int slot;
+        while ((slot = bracket.nextReadyMatch()) != 0) {
+            bracket.updateBracketWinner(bracket.matchIDOfSlot(slot), bracket.nodes[slot].player1ID);
+            played++;
+        }
+        timer.finish(played);
+    }
+}
+
+// Registration PriorityQueue (indexed 4-ary heap): inserts in random priority order,
+// lookups and removals by ID, priority changes and draining in serving order
+void benchmarkRegistrationQueue(int size, std::mt19937& rng) {
+    std::uniform_int_distribution<int> priorityDist(1, 3); // wildcard, earlybird, normal
+    const std::string name = "Player Name";
+    const std::int64_t regTime = parseRegistrationTime("2025-01-01 10:00:00 AM");
+    std::vector<int> ids = shuffledIDs(size, rng);
+
+    PriorityQueue pq;
+    {
+        BenchmarkTimer timer("RegistrationQueue", "insert", size);
+        for (int i = 0; i < size; ++i) {
+            pq.insert(Player(i + 1, name, regTime, STATUS_REGISTERED, priorityDist(rng), REG_NORMAL));
+        }
+        timer.finish(size);
+    }
+
+    {
+        // Position-map lookup, as check-in and the registration ID checks do
+        BenchmarkTimer timer("RegistrationQueue", "lookup", size);
+        for (int i = 0; i < size; ++i) {
+            const Player* player = pq.find(ids[i]);
+            if (player != nullptr) benchmarkSink += player->priority;
+        }
+        timer.finish(size);
+    }
+
+    {
+        BenchmarkTimer timer("RegistrationQueue", "reprioritize", size);
+        for (int i = 0; i < size; ++i) {
+            pq.changePriority(ids[i], 1 + (ids[i] + i) % 3);
+        }
+        timer.finish(size);
+    }
+
+    {
+        BenchmarkTimer timer("RegistrationQueue", "traverse", size);
+        for (int i = 0; i < pq.getSize(); ++i) {
+            benchmarkSink += pq.at(i).priority;
+        }
+        timer.finish(size);
+    }
+
+    {
+        // Withdraw half of the players by ID, in random order
+        int withdrawals = size / 2;
+        BenchmarkTimer timer("RegistrationQueue", "remove_by_id", size);
+        for (int i = 0; i < withdrawals; ++i) {
+            benchmarkSink += pq.removeByID(ids[i]) ? 1 : 0;
+        }
+        timer.finish(withdrawals);
+    }
+
+    {
+        int remaining = pq.getSize();
+        BenchmarkTimer timer("RegistrationQueue", "remove", size);
+        while (!pq.isEmpty()) {
+            benchmarkSink += pq.remove().playerID;
+        }
+        timer.finish(remaining);
+    }
+
+    {
+        // Bulk import path: append everything, then one heapify
+        std::vector<Player> batch;
+        batch.reserve(static_cast<size_t>(size));
+        for (int i = 0; i < size; ++i) {
+            batch.push_back(Player(i + 1, name, regTime, STATUS_REGISTERED, priorityDist(rng), REG_NORMAL));
+        }
+        PriorityQueue bulk;
+        BenchmarkTimer timer("RegistrationQueue", "bulk_insert", size);
+        bulk.insertBulk(batch);
+        timer.finish(size);
+        benchmarkSink += bulk.at(0).playerID;
+    }
+}
+
+void benchmarkSpectatorQueue(int size, int lookups, std::mt19937& rng) {
+    SpectatorQueueManager manager(size);
+    char id[16];
+    {
+        BenchmarkTimer timer("SpectatorQueue", "insert", size);
+        for (int i = 0; i < size; ++i) {
+            snprintf(id, sizeof(id), "SP%07d", i + 1);
+            manager.enqueueSpectator(new SpectatorNode(id, "Spectator Name", "General", 1, "Waiting", "09:30"));
+        }
+        timer.finish(size);
+    }
+
+    {
+        // findSpectatorById walks the circle, so only 'lookups' searches are timed
+        std::uniform_int_distribution<int> idDist(1, size);
+        BenchmarkTimer timer("SpectatorQueue", "lookup", size);
+        for (int n = 0; n < lookups; ++n) {
+            snprintf(id, sizeof(id), "SP%07d", idDist(rng));
+            benchmarkSink += manager.findSpectatorById(id)->priority;
+        }
+        timer.finish(lookups);
+    }
+
+    {
+        BenchmarkTimer timer("SpectatorQueue", "traverse", size);
+        SpectatorNode* current = manager.getFront();
+        do {
+            benchmarkSink += current->priority;
+            current = current->next;
+        } while (current != manager.getFront());
+        timer.finish(size);
+    }
+
+    {
+        BenchmarkTimer timer("SpectatorQueue", "remove", size);
+        while (SpectatorNode* node = manager.dequeueSpectator()) {
+            benchmarkSink += node->priority;
+            delete node;
+        }
+        timer.finish(size);
+    }
+}
+
+// Cost of the instrumentation itself: a bare histogram record, and a timed empty scope
+// (two clock reads plus the record) with recording on and off
+void benchmarkPerfStats(int size) {
+    static PerfStat stat("benchmark.scopedTimer");
+    {
+        BenchmarkTimer timer("PerfStats", "record", size);
+        for (int i = 0; i < size; ++i) {
+            stat.histogram.record(static_cast<std::uint64_t>(i) * 37);
+        }
+        timer.finish(size);
+    }
+    {
+        BenchmarkTimer timer("PerfStats", "scoped_timer", size);
+        for (int i = 0; i < size; ++i) {
+            ScopedTimer scope(stat);
+            benchmarkSink += i;
+        }
+        timer.finish(size);
+    }
+    perfStatsEnabled = false;
+    {
+        BenchmarkTimer timer("PerfStats", "scoped_timer_off", size);
+        for (int i = 0; i < size; ++i) {
+            ScopedTimer scope(stat);
+            benchmarkSink += i;
+        }
+        timer.finish(size);
+    }
+    perfStatsEnabled = true;
+    benchmarkSink += static_cast<long long>(stat.histogram.valueAtPercentile(50.0));
+}
+
+int main(int argc, char* argv[]) {
+    int maxSize = 1000000;
+    int lookupLimit = 200;       // Cap on timed linear-scan lookups per size
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--max") == 0) maxSize = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--lookups") == 0) lookupLimit = atoi(argv[i + 1]);
+    }
+
+    std::ostream report(std::cout.rdbuf());
+    benchmarkReport = &report;
+    NullBuffer silent;
+    std::streambuf* consoleBuffer = std::cout.rdbuf(&silent);
+
+    report << "structure,operation,size,ops,ns_per_op,allocs_per_op\n";
+    std::mt19937 rng(12345);
+    for (int size = 1000; size <= maxSize; size *= 10) {
+        int lookups = size < lookupLimit ? size : lookupLimit;
+        benchmarkPlayerList(size, rng);
+        benchmarkMatchQueue(size, rng);
+        benchmarkBracket(size, rng);
+        benchmarkRegistrationQueue(size, rng);
+        benchmarkSpectatorQueue(size, lookups, rng);
+        benchmarkPerfStats(size);
+        report.flush();
+    }
+
+    std::cout.rdbuf(consoleBuffer);
+    std::cerr << "checksum " << benchmarkSink << std::endl;
+    return 0;
+}
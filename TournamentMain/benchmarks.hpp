@@ -0,0 +1,47 @@
+#ifndef BENCHMARKS_HPP
+#define BENCHMARKS_HPP
+
+#include <chrono>   // For steady_clock
+#include <iostream>
+
+// Shared pieces of the container benchmark program (benchmarks.cpp has main()).
+// Every measurement is written as one CSV row:
+//   structure,operation,size,ops,ns_per_op,allocs_per_op
+
+// Calls to the global operator new so far (counted by the replacements in benchmarks.cpp)
+extern long long benchmarkAllocations;
+
+// Destination of the result rows. std::cout itself is silenced while the benchmarks run,
+// so the containers' own status messages do not flood the report.
+extern std::ostream* benchmarkReport;
+
+// Folds results into a value that is printed at the end, so no loop is optimized away
+extern long long benchmarkSink;
+
+// Times one operation: create it right before the measured loop and call finish() right
+// after it with the number of operations the loop performed
+class BenchmarkTimer {
+public:
+    BenchmarkTimer(const char* structureName, const char* operationName, int elementCount)
+        : structure(structureName), operation(operationName), size(elementCount),
+          allocationsAtStart(benchmarkAllocations), start(std::chrono::steady_clock::now()) {}
+
+    void finish(long long ops) {
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        long long allocations = benchmarkAllocations - allocationsAtStart;
+        double nanoseconds = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        if (ops < 1) ops = 1;
+        *benchmarkReport << structure << "," << operation << "," << size << "," << ops << ","
+            << nanoseconds / static_cast<double>(ops) << ","
+            << static_cast<double>(allocations) / static_cast<double>(ops) << "\n";
+    }
+
+private:
+    const char* structure;
+    const char* operation;
+    int size;
+    long long allocationsAtStart;
+    std::chrono::steady_clock::time_point start;
+};
+
+#endif // BENCHMARKS_HPP
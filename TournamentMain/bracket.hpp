@@ -2,264 +2,371 @@
 #define BRACKET_HPP
 
 #include <iostream>
+#include <fstream>   // For saving/loading the flat bracket buffer
 #include <string>
-#include <queue> // For level-order traversal during build and print
-#include <vector> // To temporarily hold players for bracket creation
-#include <cmath> // For log2 and pow
-#include <algorithm> // For std::min
+#include <vector>    // Contiguous storage for the whole bracket
+#include <cstdint>   // For uint32_t
 #include "player.hpp" // Include PlayerList to update player stats
 
-// Represents a node in the binary tree (tournament bracket)
+// Represents one slot of the implicit bracket tree: a match, or an entrant at the leaves
 struct BracketNode {
-    int matchID;
-    int player1ID; // ID of player 1 in this match
-    int player2ID; // ID of player 2 in this match
-    int winnerID;  // ID of the winner of this match
-    BracketNode* left;
-    BracketNode* right;
-
-    // Constructor for a match node
-    BracketNode(int id = 0) : matchID(id), player1ID(0), player2ID(0), winnerID(0), left(nullptr), right(nullptr) {}
-
-    // Constructor for a player node (leaf of the bracket)
-    BracketNode(int id, int playerID) : matchID(id), player1ID(playerID), player2ID(0), winnerID(playerID), left(nullptr), right(nullptr) {}
+    int player1ID; // ID of player 1 in this match (the entrant itself at a leaf)
+    int player2ID; // ID of player 2 in this match (unused at a leaf)
+    int winnerID;  // ID of the winner of this match (the entrant itself at a leaf)
+
+    BracketNode() : player1ID(0), player2ID(0), winnerID(0) {}
 };
 
-// Tournament Bracket (Binary Tree)
+// Tournament Bracket (Binary Tree) stored implicitly in one contiguous array, heap style:
+// slot 1 is the final, the children of match k are slots 2k and 2k+1, and the entrants sit
+// in the leaf slots [leafCount, 2 * leafCount). Match k has ID matchIDBase + k, so match
+// lookups, winner updates and parent lookups are all plain arithmetic on the slot number.
+// Advancement is event driven: a decided match pushes its winner into the parent slot,
+// and a parent whose two sides are both filled is appended to the ready-match log.
 class TournamentBracket {
 public:
-    BracketNode* root; // Root of the bracket tree
-    int nextBracketMatchID; // Counter for unique match IDs in the bracket
+    std::vector<BracketNode> nodes; // nodes[0] is unused so that the final sits at slot 1
+    int leafCount;                  // Number of leaf slots (a power of two), 0 if no bracket
+    int matchIDBase;                // Match k has ID matchIDBase + k (the owner sets it before building
+                                    // so bracket IDs do not overlap its other match IDs)
+    std::vector<int> readyLog;      // Match slots in the order they became playable (each once)
+    size_t drainCursor;             // readyLog entries already taken by nextReadyMatch()
+
+    TournamentBracket() : leafCount(0), matchIDBase(1000), drainCursor(0) {} // Standalone brackets number from 1001 (the final)
+
+    // Releases the whole bracket at once
+    void clear() {
+        nodes.clear();
+        leafCount = 0;
+        readyLog.clear();
+        drainCursor = 0;
+    }
+
+    bool isEmpty() const {
+        return leafCount == 0;
+    }
 
-    TournamentBracket() : root(nullptr), nextBracketMatchID(1001) {} // Start bracket IDs from 1001
+    // Slot arithmetic for the implicit tree
+    static int parentSlot(int slot) { return slot >> 1; }
+    static int leftChildSlot(int slot) { return slot << 1; }
+    static int rightChildSlot(int slot) { return (slot << 1) | 1; }
+    int matchIDOfSlot(int slot) const { return matchIDBase + slot; }
 
-    // Destructor to clear the entire bracket
-    ~TournamentBracket() {
-        clearBracket(root);
-        root = nullptr;
+    // Returns the slot of a match ID, or 0 if the ID is not a match of this bracket
+    int slotOfMatch(int matchID) const {
+        int slot = matchID - matchIDBase;
+        return (slot >= 1 && slot < leafCount) ? slot : 0;
     }
 
-    // Recursively deletes all nodes in the bracket
-    void clearBracket(BracketNode* node) {
-        if (node == nullptr) return;
-        clearBracket(node->left);
-        clearBracket(node->right);
-        delete node;
+    // Leaf offset of a 0-based seed in a bracket with leafCount leaves (a power of two).
+    // The seed's Gray code, bit-reversed over log2(leafCount) bits, gives the standard
+    // seeding order (1, 8, 4, 5, 2, 7, 3, 6 for eight leaves): seed s meets seed
+    // leafCount-1-s in the first round, and the top two seeds land in opposite halves,
+    // so they can only meet in the final.
+    static int seedPosition(int seed, int leaves) {
+        int bits = 0;
+        while ((1 << bits) < leaves) {
+            bits++;
+        }
+        if (bits == 0) return 0;
+        uint32_t x = static_cast<uint32_t>(seed ^ (seed >> 1)); // Gray code
+        x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+        x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+        x = ((x >> 4) & 0x0F0F0F0Fu) | ((x & 0x0F0F0F0Fu) << 4);
+        x = ((x >> 8) & 0x00FF00FFu) | ((x & 0x00FF00FFu) << 8);
+        x = (x >> 16) | (x << 16);
+        return static_cast<int>(x >> (32 - bits));
     }
 
-    // Builds the knockout bracket based on a list of qualified players
+    // Builds the knockout bracket based on a list of qualified players in seed order
     void buildBracket(PlayerList* qualifiedPlayers) {
-        if (qualifiedPlayers == nullptr || qualifiedPlayers->head == nullptr || qualifiedPlayers->getPlayerCount() < 2) {
+        std::vector<int> seededIDs;
+        if (qualifiedPlayers != nullptr) {
+            seededIDs.reserve(static_cast<size_t>(qualifiedPlayers->getPlayerCount()));
+            for (Player* current = qualifiedPlayers->head; current != nullptr; current = current->next) {
+                seededIDs.push_back(current->playerID);
+            }
+        }
+        buildBracket(seededIDs);
+    }
+
+    // Builds the knockout bracket from player IDs in seed order (best seed first).
+    // Any entrant count is accepted: the leaves are rounded up to the next power of two
+    // and the missing entrants become byes for the top seeds, who advance straight to
+    // round 2. Runs in O(n) with a single allocation for the whole tree.
+    void buildBracket(const std::vector<int>& seededIDs) {
+        clear();
+        int numPlayers = static_cast<int>(seededIDs.size());
+        if (numPlayers < 2) {
             std::cout << "Not enough qualified players to build a knockout bracket." << std::endl;
-            root = nullptr;
             return;
         }
 
-        // Convert PlayerList to a vector for easier indexing/pairing
-        std::vector<Player*> players;
-        Player* current = qualifiedPlayers->head;
-        while (current != nullptr) {
-            players.push_back(current);
-            current = current->next;
+        leafCount = 1;
+        while (leafCount < numPlayers) {
+            leafCount <<= 1;
         }
+        nodes.assign(static_cast<size_t>(2 * leafCount), BracketNode());
 
-        int numPlayers = static_cast<int>(players.size());
-        if ((numPlayers & (numPlayers - 1)) != 0) { // Check if numPlayers is a power of 2
-            std::cout << "Warning: Number of qualified players (" << numPlayers << ") is not a power of 2. Bracket might have byes or uneven matches." << std::endl;
-            // For simplicity, we'll proceed, but a real system might handle this more robustly.
-            // For example, byes in early rounds. Here we'll just use the players we have.
+        // Place each seed on its leaf; seeds past numPlayers simply leave their leaf empty
+        for (int seed = 0; seed < numPlayers; ++seed) {
+            BracketNode& leaf = nodes[leafCount + seedPosition(seed, leafCount)];
+            leaf.player1ID = seededIDs[seed];
+            leaf.winnerID = seededIDs[seed];
         }
 
-        // Create initial round of player nodes (leaves of the bracket)
-        std::queue<BracketNode*> q;
-        for (Player* p : players) {
-            q.push(new BracketNode(0, p->playerID)); // Player nodes have matchID 0
+        // Fill the first-round matches from their leaves. More than half the leaves are
+        // taken, so a first-round match has at most one empty side: that entrant has a bye.
+        // Real matches are ready at once; byes advance and may make a round-2 match ready.
+        int byes = 0;
+        for (int slot = leafCount / 2; slot < leafCount; ++slot) {
+            BracketNode& match = nodes[slot];
+            match.player1ID = nodes[leftChildSlot(slot)].winnerID;
+            match.player2ID = nodes[rightChildSlot(slot)].winnerID;
+            if (match.player1ID == 0 || match.player2ID == 0) {
+                match.winnerID = match.player1ID != 0 ? match.player1ID : match.player2ID;
+                advanceWinner(slot);
+                byes++;
+            }
+            else {
+                readyLog.push_back(slot);
+            }
         }
 
-        // Build the tree level by level
-        while (q.size() > 1) {
-            BracketNode* p1_node = q.front(); q.pop();
-            BracketNode* p2_node = q.front(); q.pop();
-
-            BracketNode* match_node = new BracketNode(nextBracketMatchID++);
-            match_node->left = p1_node;
-            match_node->right = p2_node;
-
-            // Set the initial player IDs for the first round of matches
-            // These are the winners of the leaf 'player nodes' (which is just the player ID itself)
-            match_node->player1ID = p1_node->winnerID;
-            match_node->player2ID = p2_node->winnerID;
-
-            q.push(match_node); // Add the newly created match node to the queue for the next level
+        if (byes > 0) {
+            std::cout << numPlayers << " qualified players: " << byes << " top seed(s) receive a first-round bye." << std::endl;
         }
-        root = q.front(); // The last node in the queue is the root (final match)
-        q.pop();
     }
 
+    // True if both players of the match are known and it has not been decided yet
+    bool isReady(int slot) const {
+        const BracketNode& match = nodes[slot];
+        return match.player1ID != 0 && match.player2ID != 0 && match.winnerID == 0;
+    }
 
-    // Updates the winner of a specific match within the bracket
-    void updateBracketWinner(int matchID, int winnerID) {
-        BracketNode* node = findNode(root, matchID);
-        if (node != nullptr) {
-            node->winnerID = winnerID;
-            std::cout << "Updated Bracket Match " << matchID << " winner to " << winnerID << std::endl;
-        }
-        else {
+    // Records the winner of a ready match and moves them into their side of the parent
+    // match, enqueuing the parent once both of its sides are known. O(1) per result.
+    // Returns false (and changes nothing) for unknown, unready or already decided matches.
+    bool updateBracketWinner(int matchID, int winnerID) {
+        int slot = slotOfMatch(matchID);
+        if (slot == 0) {
             std::cerr << "Warning: Knockout Match with ID " << matchID << " not found." << std::endl;
+            return false;
+        }
+        BracketNode& match = nodes[slot];
+        if (match.winnerID != 0) {
+            std::cerr << "Warning: Knockout Match " << matchID << " has already been decided." << std::endl;
+            return false;
         }
+        if (match.player1ID == 0 || match.player2ID == 0) {
+            std::cerr << "Warning: Knockout Match " << matchID << " is not ready; its players are not known yet." << std::endl;
+            return false;
+        }
+        if (winnerID != match.player1ID && winnerID != match.player2ID) {
+            std::cerr << "Warning: Player " << winnerID << " is not playing in Knockout Match " << matchID << "." << std::endl;
+            return false;
+        }
+        match.winnerID = winnerID;
+        advanceWinner(slot);
+        std::cout << "Updated Bracket Match " << matchID << " winner to " << winnerID << std::endl;
+        return true;
     }
 
-    // Helper to find a node by match ID (pre-order traversal)
-    BracketNode* findNode(BracketNode* node, int id) {
-        if (node == nullptr) return nullptr;
-        if (node->matchID == id) return node;
-        BracketNode* found = findNode(node->left, id);
-        if (found != nullptr) return found;
-        return findNode(node->right, id);
+    // Takes the next ready match in FIFO order, skipping ones already decided through
+    // results; returns its slot, or 0 when nothing is playable right now
+    int nextReadyMatch() {
+        while (drainCursor < readyLog.size()) {
+            int slot = readyLog[drainCursor++];
+            if (nodes[slot].winnerID == 0) return slot;
+        }
+        return 0;
     }
 
-    // Prints the bracket in a level-order (breadth-first) fashion
-    void printBracket(BracketNode* rootNode, int initialPlayerCount) { // Added initialPlayerCount parameter
-        if (rootNode == nullptr) {
+    // Prints the bracket round by round, straight from the array levels
+    void printBracket() {
+        if (isEmpty()) {
             std::cout << "Bracket is empty." << std::endl;
             return;
         }
 
         std::cout << "\n--- Tournament Knockout Bracket ---" << std::endl;
-        std::queue<BracketNode*> q;
-        q.push(rootNode);
-
-        // Calculate total levels for correct round numbering
-        int totalLevels = 0;
-        if (initialPlayerCount > 0) {
-            // For N players, there are log2(N) match rounds + 1 player level
-            totalLevels = static_cast<int>(std::log2(initialPlayerCount)) + 1;
-        }
-        else {
-            std::cout << "Warning: Initial player count is 0. Round numbering might be off." << std::endl;
-            totalLevels = 1; // Default to 1 round if unknown
+
+        // Level d holds slots [2^d, 2^(d+1)); the leaves are the deepest level
+        int depth = 0;
+        while ((1 << depth) < leafCount) {
+            depth++;
         }
 
-        int currentInternalLevel = 0; // This goes from 0 (root) to totalLevels - 1 (players)
+        for (int level = 0; level <= depth; ++level) {
+            int displayRound = depth + 1 - level; // Map level to display round
+            int firstSlot = 1 << level;
+            int lastSlot = (1 << (level + 1)) - 1;
 
-        while (!q.empty()) {
-            int nodesAtCurrentLevel = static_cast<int>(q.size());
-            int displayRound = totalLevels - currentInternalLevel; // Map internal level to display round
+            if (level == depth) { // This is the last level (players)
+                std::cout << "\n--- Initial Players (Round " << displayRound << ") ---" << std::endl;
+                for (int slot = firstSlot; slot <= lastSlot; ++slot) {
+                    if (nodes[slot].player1ID == 0) continue; // Empty leaf (bye)
+                    std::cout << "    Player: " << nodes[slot].player1ID << " (QUALIFIED)" << std::endl;
+                }
+                continue;
+            }
 
-            // Only print round header if there are matches/players in this round
-            if (nodesAtCurrentLevel > 0) {
-                if (currentInternalLevel == totalLevels - 1) { // This is the last level (players)
-                    std::cout << "\n--- Initial Players (Round " << displayRound << ") ---" << std::endl;
+            std::cout << "\n--- Round " << displayRound << " ---" << std::endl;
+            for (int slot = firstSlot; slot <= lastSlot; ++slot) {
+                const BracketNode& current = nodes[slot];
+                std::cout << "    Match " << matchIDOfSlot(slot) << ": ";
+                if (level == depth - 1 && (current.player1ID == 0 || current.player2ID == 0)) {
+                    // First-round match with an empty leaf
+                    std::cout << "P" << (current.player1ID != 0 ? current.player1ID : current.player2ID) << " vs BYE";
                 }
                 else {
-                    std::cout << "\n--- Round " << displayRound << " ---" << std::endl;
+                    // TBD marks a side whose previous-round match is still undecided
+                    printSide(current.player1ID);
+                    std::cout << " vs ";
+                    printSide(current.player2ID);
                 }
-            }
-
-
-            // This loop processes all nodes at the current level
-            for (int i = 0; i < nodesAtCurrentLevel; ++i) {
-                BracketNode* current = q.front();
-                q.pop();
 
-                if (current->matchID == 0) { // It's a player node (leaf)
-                    std::cout << "    Player: " << current->player1ID;
-                    if (current->winnerID != 0 && current->winnerID == current->player1ID) {
-                        std::cout << " (QUALIFIED)";
-                    }
-                    std::cout << std::endl;
+                if (current.winnerID != 0) {
+                    std::cout << " (Winner: " << current.winnerID << ")";
                 }
-                else { // It's a match node
-                    std::cout << "    Match " << current->matchID << ": ";
-                    if (current->player1ID != 0 && current->player2ID != 0) {
-                        std::cout << "P" << current->player1ID << " vs P" << current->player2ID;
-                    }
-                    else {
-                        // This indicates players are not yet determined from previous rounds
-                        std::cout << "TBD vs TBD";
-                    }
-
-                    if (current->winnerID != 0) {
-                        std::cout << " (Winner: " << current->winnerID << ")";
-                    }
-                    else {
-                        std::cout << " (Pending)";
-                    }
-                    std::cout << std::endl;
-
-                    // Enqueue children to process the "previous" round
-                    if (current->left != nullptr) {
-                        q.push(current->left);
-                    }
-                    if (current->right != nullptr) {
-                        q.push(current->right);
-                    }
+                else {
+                    std::cout << " (Pending)";
                 }
+                std::cout << std::endl;
             }
-            currentInternalLevel++; // Increment internal level counter
         }
         std::cout << "-----------------------------------" << std::endl;
     }
 
+    // Prints one side of a match: the player, or TBD if not yet known
+    static void printSide(int playerID) {
+        if (playerID != 0) {
+            std::cout << "P" << playerID;
+        }
+        else {
+            std::cout << "TBD";
+        }
+    }
+
+    // Serializes the whole bracket as one flat int buffer:
+    // leafCount, matchIDBase, then player1ID/player2ID/winnerID for slots 1 .. 2*leafCount-1
+    void serialize(std::vector<int>& buffer) const {
+        buffer.clear();
+        buffer.reserve(2 + 3 * nodes.size());
+        buffer.push_back(leafCount);
+        buffer.push_back(matchIDBase);
+        for (size_t slot = 1; slot < nodes.size(); ++slot) {
+            buffer.push_back(nodes[slot].player1ID);
+            buffer.push_back(nodes[slot].player2ID);
+            buffer.push_back(nodes[slot].winnerID);
+        }
+    }
+
+    // Restores a bracket produced by serialize(); returns false if the buffer is malformed
+    bool deserialize(const std::vector<int>& buffer) {
+        if (buffer.size() < 2) return false;
+        int leaves = buffer[0];
+        if (leaves < 0 || (leaves & (leaves - 1)) != 0 || buffer.size() != 2 + 3 * static_cast<size_t>(leaves == 0 ? 0 : 2 * leaves - 1)) {
+            return false;
+        }
+        clear();
+        leafCount = leaves;
+        matchIDBase = buffer[1];
+        nodes.assign(static_cast<size_t>(leaves == 0 ? 0 : 2 * leaves), BracketNode());
+        size_t read = 2;
+        for (size_t slot = 1; slot < nodes.size(); ++slot) {
+            nodes[slot].player1ID = buffer[read++];
+            nodes[slot].player2ID = buffer[read++];
+            nodes[slot].winnerID = buffer[read++];
+        }
+        // Rebuild the ready log, deepest round first
+        for (int slot = leafCount - 1; slot >= 1; --slot) {
+            if (isReady(slot)) readyLog.push_back(slot);
+        }
+        return true;
+    }
+
+    // Writes the flat buffer to a binary file in a single write
+    bool saveToFile(const char* filename) const {
+        std::vector<int> buffer;
+        serialize(buffer);
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size() * sizeof(int)));
+        return static_cast<bool>(file);
+    }
+
+    // Reads a bracket written by saveToFile()
+    bool loadFromFile(const char* filename) {
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) return false;
+        std::streamoff bytes = file.tellg();
+        if (bytes < 0 || bytes % static_cast<std::streamoff>(sizeof(int)) != 0) return false;
+        std::vector<int> buffer(static_cast<size_t>(bytes) / sizeof(int));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(buffer.data()), bytes);
+        return static_cast<bool>(file) && deserialize(buffer);
+    }
+
 
     // --- New Simulation Logic ---
-    // Public interface to start the knockout stage simulation
+    // Drains the ready-match queue; every decided match may make its parent ready,
+    // so the whole bracket is played out round by round without walking the tree
     void simulateKnockoutMatches(PlayerList* allPlayersList) {
-        if (root == nullptr) {
+        if (isEmpty()) {
             std::cout << "No knockout bracket to simulate." << std::endl;
             return;
         }
         std::cout << "\n--- Running Knockout Stage Simulation ---" << std::endl;
-        // Call the recursive helper to simulate matches from bottom-up
-        simulateMatchNode(root, allPlayersList);
+        for (int slot = nextReadyMatch(); slot != 0; slot = nextReadyMatch()) {
+            simulateMatchSlot(slot, allPlayersList);
+        }
         std::cout << "--- Knockout Stage Simulation Complete ---" << std::endl;
     }
 
 private:
-    // Recursive helper to simulate matches within the bracket
-    int simulateMatchNode(BracketNode* node, PlayerList* allPlayersList) {
-        if (node == nullptr) {
-            return 0; // No player/winner from a null node
+    // Copies the winner of a slot into its side of the parent match and enqueues the
+    // parent when that completes its pairing
+    void advanceWinner(int slot) {
+        if (slot <= 1) return; // The final has no parent
+        int parent = parentSlot(slot);
+        if (slot & 1) {
+            nodes[parent].player2ID = nodes[slot].winnerID;
         }
-
-        // If it's a player node (leaf), it's already a winner of its "match" (itself)
-        if (node->matchID == 0) {
-            return node->winnerID;
+        else {
+            nodes[parent].player1ID = nodes[slot].winnerID;
         }
+        if (isReady(parent)) {
+            readyLog.push_back(parent);
+        }
+    }
 
-        // Recursively simulate children matches to get their winners
-        int player1_from_child = simulateMatchNode(node->left, allPlayersList);
-        int player2_from_child = simulateMatchNode(node->right, allPlayersList);
-
-        // Set player IDs for the current match from its children's winners
-        node->player1ID = player1_from_child;
-        node->player2ID = player2_from_child;
+    // Decides one ready match
+    void simulateMatchSlot(int slot, PlayerList* allPlayersList) {
+        BracketNode& node = nodes[slot];
 
-        // If the match is not yet played (winnerID == 0) and both players are determined
-        if (node->winnerID == 0 && node->player1ID != 0 && node->player2ID != 0) {
-            // Simulate winner (e.g., randomly pick one, or just pick player1 for simplicity)
-            int winner = node->player1ID; // Simple simulation: Player 1 always wins
-            int loser = node->player2ID;
+        // Simulate winner (e.g., randomly pick one, or just pick player1 for simplicity)
+        int winner = node.player1ID; // Simple simulation: Player 1 always wins
+        int loser = node.player2ID;
 
-            node->winnerID = winner;
+        node.winnerID = winner;
 
-            std::cout << "Simulating Knockout Match " << node->matchID << ": P" << node->player1ID
-                << " vs P" << node->player2ID << ". Winner: P" << winner << std::endl;
+        std::cout << "Simulating Knockout Match " << matchIDOfSlot(slot) << ": P" << node.player1ID
+            << " vs P" << node.player2ID << ". Winner: P" << winner << std::endl;
 
-            // Update player statuses and wins/losses
-            // If it's the final match, the winner gets "Winner" status
-            if (node == root) { // Assuming root is the final match
-                allPlayersList->updatePlayerStatus(winner, "Winner");
-                allPlayersList->updatePlayerStatus(loser, "Eliminated");
-            }
-            else {
-                allPlayersList->updatePlayerStatus(winner, "Advanced");
-                allPlayersList->updatePlayerStatus(loser, "Eliminated");
-            }
+        // Update player statuses and wins/losses
+        // If it's the final match, the winner gets "Winner" status
+        if (slot == 1) {
+            allPlayersList->updatePlayerStatus(winner, STATUS_WINNER);
+            allPlayersList->updatePlayerStatus(loser, STATUS_ELIMINATED);
+        }
+        else {
+            allPlayersList->updatePlayerStatus(winner, STATUS_ADVANCED);
+            allPlayersList->updatePlayerStatus(loser, STATUS_ELIMINATED);
         }
-        return node->winnerID; // Return the winner of this match
+        advanceWinner(slot);
     }
 
 };
 
-#endif // BRACKET_HPP
\ No newline at end of file
+#endif // BRACKET_HPP
@@ -2,31 +2,53 @@
 #include <iostream>
 #include <fstream>
 #include <cstring>
+#include <string>
 #include "game_result.hpp"
+#include "platform_compat.hpp" // strncpy_s/strcpy_s outside MSVC
+#include "perf_stats.hpp"
 using namespace std;
 
-void addMatchResult(MatchResult results[], int &count) {
-    cout << "\nEnter Match ID: ";
-    cin >> results[count].matchID;
-    cout << "Enter Player 1: ";
-    cin >> results[count].player1;
-    cout << "Enter Player 2: ";
-    cin >> results[count].player2;
-    cout << "Enter Score for " << results[count].player1 << ": ";
-    cin >> results[count].score1;
-    cout << "Enter Score for " << results[count].player2 << ": ";
-    cin >> results[count].score2;
+bool recordMatchResult(MatchResult results[], int &count, const char* matchID, const char* player1, const char* player2, int score1, int score2) {
+    if (count >= MAX_MATCH_RESULTS) {
+        cout << "Result log is full (" << MAX_MATCH_RESULTS << " matches).\n";
+        return false;
+    }
+    MatchResult& result = results[count];
+    strncpy_s(result.matchID, sizeof(result.matchID), matchID, sizeof(result.matchID) - 1);
+    strncpy_s(result.player1, sizeof(result.player1), player1, sizeof(result.player1) - 1);
+    strncpy_s(result.player2, sizeof(result.player2), player2, sizeof(result.player2) - 1);
+    result.score1 = score1;
+    result.score2 = score2;
 
-    if (results[count].score1 > results[count].score2)
-        strcpy_s(results[count].winner, results[count].player1);
+    if (result.score1 > result.score2)
+        strcpy_s(result.winner, result.player1);
     else
-        strcpy_s(results[count].winner, results[count].player2);
+        strcpy_s(result.winner, result.player2);
 
     count++;
     cout << "Match recorded successfully.\n";
+    return true;
+}
+
+void addMatchResult(MatchResult results[], int &count) {
+    string matchID, player1, player2;
+    int score1, score2;
+    cout << "\nEnter Match ID: ";
+    cin >> matchID;
+    cout << "Enter Player 1: ";
+    cin >> player1;
+    cout << "Enter Player 2: ";
+    cin >> player2;
+    cout << "Enter Score for " << player1 << ": ";
+    cin >> score1;
+    cout << "Enter Score for " << player2 << ": ";
+    cin >> score2;
+
+    recordMatchResult(results, count, matchID.c_str(), player1.c_str(), player2.c_str(), score1, score2);
 }
 
 void saveResultsToFile(MatchResult results[], int count, const char* filename) {
+    PERF_SCOPE("results.saveResultsToFile");
     ofstream fout(filename);
     for (int i = 0; i < count; i++) {
         fout << results[i].matchID << ","
@@ -40,9 +62,10 @@ void saveResultsToFile(MatchResult results[], int count, const char* filename) {
 }
 
 void loadResultsFromFile(MatchResult results[], int &count, const char* filename) {
+    PERF_SCOPE("results.loadResultsFromFile");
     ifstream fin(filename);
     count = 0;
-    while (fin.getline(results[count].matchID, 10, ',')) {
+    while (count < MAX_MATCH_RESULTS && fin.getline(results[count].matchID, 10, ',')) {
         fin.getline(results[count].player1, 30, ',');
         fin.getline(results[count].player2, 30, ',');
         fin >> results[count].score1;
@@ -53,6 +76,7 @@ void loadResultsFromFile(MatchResult results[], int &count, const char* filename
         count++;
     }
     fin.close();
+    PERF_COUNT("results.matchesLoaded", count);
 }
 
 void displayResults(MatchResult results[], int count) {
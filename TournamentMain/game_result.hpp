@@ -11,7 +11,11 @@ struct MatchResult {
     char winner[30];
 };
 
+const int MAX_MATCH_RESULTS = 100; // Capacity of a result log array
+
 void addMatchResult(MatchResult results[], int &count);
+// Appends one result without prompting (the winner is the higher score); false if the log is full
+bool recordMatchResult(MatchResult results[], int &count, const char* matchID, const char* player1, const char* player2, int score1, int score2);
 void saveResultsToFile(MatchResult results[], int count, const char* filename);
 void loadResultsFromFile(MatchResult results[], int &count, const char* filename);
 void displayResults(MatchResult results[], int count);
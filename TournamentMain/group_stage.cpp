@@ -0,0 +1,66 @@
+#include "group_stage.hpp"
+#include <thread>
+#include <algorithm> // For std::min
+
+std::vector<GroupPairing> generateCircleRoundRobin(const std::vector<int>& playerIDs) {
+    std::vector<GroupPairing> pairings;
+    int playerCount = static_cast<int>(playerIDs.size());
+    if (playerCount < 2) return pairings;
+
+    // Pad odd groups with a bye (ID 0); whoever meets it sits the round out
+    std::vector<int> circle(playerIDs);
+    if (playerCount % 2 != 0) {
+        circle.push_back(0);
+    }
+    int n = static_cast<int>(circle.size());
+    int rounds = n - 1;
+    pairings.reserve(static_cast<size_t>(rounds) * (n / 2));
+
+    std::vector<int> order(static_cast<size_t>(n));
+    for (int round = 0; round < rounds; ++round) {
+        // Position 0 stays fixed; everyone else rotates by one place per round
+        order[0] = circle[0];
+        for (int k = 1; k < n; ++k) {
+            order[k] = circle[1 + (k - 1 + round) % (n - 1)];
+        }
+
+        // Fold the circle: position i plays position n - 1 - i
+        for (int i = 0; i < n / 2; ++i) {
+            int p1 = order[i];
+            int p2 = order[n - 1 - i];
+            if (p1 == 0 || p2 == 0) continue; // Bye
+            GroupPairing pairing;
+            pairing.round = round + 1;
+            pairing.player1ID = p1;
+            pairing.player2ID = p2;
+            pairings.push_back(pairing);
+        }
+    }
+    return pairings;
+}
+
+void generateGroupRoundRobins(const std::vector<std::vector<int>>& groups, std::vector<std::vector<GroupPairing>>& pairings) {
+    int groupCount = static_cast<int>(groups.size());
+    pairings.assign(static_cast<size_t>(groupCount), std::vector<GroupPairing>());
+    if (groupCount == 0) return;
+
+    int workerCount = static_cast<int>(std::thread::hardware_concurrency());
+    workerCount = std::min(std::max(workerCount, 1), groupCount);
+
+    // Groups are independent, so each worker takes every workerCount-th group
+    // and writes only its own entries of 'pairings'
+    auto generateShare = [&groups, &pairings, groupCount, workerCount](int worker) {
+        for (int g = worker; g < groupCount; g += workerCount) {
+            pairings[g] = generateCircleRoundRobin(groups[g]);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int w = 1; w < workerCount; ++w) {
+        workers.emplace_back(generateShare, w);
+    }
+    generateShare(0); // The calling thread takes the first share
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+}
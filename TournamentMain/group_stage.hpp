@@ -0,0 +1,23 @@
+#ifndef GROUP_STAGE_HPP
+#define GROUP_STAGE_HPP
+
+#include <vector>
+
+// One pairing produced by the round-robin generator
+struct GroupPairing {
+    int round;     // 1-based round within the group
+    int player1ID;
+    int player2ID;
+};
+
+// Builds a full round robin for one group with the circle method: the first player
+// stays fixed while the others rotate one place per round, so every pair meets exactly
+// once and nobody appears twice in the same round. Odd groups get a bye each round
+// (the bye pairing is simply left out). Pairings come back ordered by round.
+std::vector<GroupPairing> generateCircleRoundRobin(const std::vector<int>& playerIDs);
+
+// Generates the round robin of every group, spreading the groups over worker threads.
+// groups[g] holds the player IDs of group g; the result for group g is stored in pairings[g].
+void generateGroupRoundRobins(const std::vector<std::vector<int>>& groups, std::vector<std::vector<GroupPairing>>& pairings);
+
+#endif // GROUP_STAGE_HPP
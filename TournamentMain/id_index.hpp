@@ -0,0 +1,125 @@
+#ifndef ID_INDEX_HPP
+#define ID_INDEX_HPP
+
+#include <vector>
+#include <cstddef> // For size_t
+
+// Open-addressing hash map from a player ID to an int value (a slot, a position, ...).
+// Linear probing over a power-of-two table; erase() shifts the following entries
+// back into the hole, so lookups never have to skip over deleted buckets.
+class IdIndex {
+public:
+    IdIndex() : used(0) {}
+
+    // Removes every entry but keeps the allocated table
+    void clear() {
+        for (size_t i = 0; i < slots.size(); ++i) {
+            slots[i].occupied = false;
+        }
+        used = 0;
+    }
+
+    // Makes room for at least 'count' entries without rehashing
+    void reserve(int count) {
+        size_t wanted = 16;
+        while (wanted < static_cast<size_t>(count) * 2) {
+            wanted <<= 1;
+        }
+        if (wanted > slots.size()) {
+            rehash(wanted);
+        }
+    }
+
+    // Adds or replaces the value stored for 'id'
+    void insert(int id, int value) {
+        if ((used + 1) * 2 > slots.size()) {
+            rehash(slots.empty() ? 16 : slots.size() * 2);
+        }
+        size_t i = probeStart(id);
+        while (slots[i].occupied) {
+            if (slots[i].id == id) {
+                slots[i].value = value;
+                return;
+            }
+            i = (i + 1) & (slots.size() - 1);
+        }
+        slots[i].id = id;
+        slots[i].value = value;
+        slots[i].occupied = true;
+        used++;
+    }
+
+    // Returns the value stored for 'id', or -1 if it is not indexed
+    int find(int id) const {
+        if (slots.empty()) return -1;
+        size_t i = probeStart(id);
+        while (slots[i].occupied) {
+            if (slots[i].id == id) {
+                return slots[i].value;
+            }
+            i = (i + 1) & (slots.size() - 1);
+        }
+        return -1;
+    }
+
+    bool contains(int id) const { return find(id) != -1; }
+
+    // Removes 'id'; returns false if it was not indexed
+    bool erase(int id) {
+        if (slots.empty()) return false;
+        size_t mask = slots.size() - 1;
+        size_t i = probeStart(id);
+        while (slots[i].occupied && slots[i].id != id) {
+            i = (i + 1) & mask;
+        }
+        if (!slots[i].occupied) return false;
+
+        // Backward-shift deletion: move later entries of the probe run into the hole
+        // unless their home bucket lies cyclically after the hole
+        size_t hole = i;
+        for (size_t j = (hole + 1) & mask; slots[j].occupied; j = (j + 1) & mask) {
+            size_t home = probeStart(slots[j].id);
+            bool movable = hole <= j ? (home <= hole || home > j) : (home <= hole && home > j);
+            if (movable) {
+                slots[hole] = slots[j];
+                hole = j;
+            }
+        }
+        slots[hole].occupied = false;
+        used--;
+        return true;
+    }
+
+    size_t size() const { return used; }
+
+private:
+    struct Bucket {
+        int id;
+        int value;
+        bool occupied;
+    };
+
+    std::vector<Bucket> slots;
+    size_t used; // Number of occupied buckets
+
+    // Fibonacci hashing spreads sequential IDs across the table
+    size_t probeStart(int id) const {
+        unsigned long long h = static_cast<unsigned int>(id) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(h >> 32) & (slots.size() - 1);
+    }
+
+    void rehash(size_t newSize) {
+        std::vector<Bucket> old;
+        old.swap(slots);
+        Bucket empty = { 0, 0, false };
+        slots.assign(newSize, empty);
+        used = 0;
+        for (size_t i = 0; i < old.size(); ++i) {
+            if (old[i].occupied) {
+                insert(old[i].id, old[i].value);
+            }
+        }
+    }
+};
+
+#endif // ID_INDEX_HPP
@@ -0,0 +1,50 @@
+#include "id_registry.hpp"
+#include "tournament_registration.hpp"
+#include "withdrawal_store.hpp"
+#include "mapped_file.hpp"
+#include "text_fields.hpp"
+#include "perf_stats.hpp"
+#include <cstring> // For memchr
+
+void IdRegistry::load(const PriorityQueue& pq, const char* checkedInFilename, const WithdrawalStore& withdrawals) {
+    PERF_SCOPE("registration.idRegistryLoad");
+    idStates.clear();
+    idStates.reserve(pq.getSize());
+    for (int i = 0; i < pq.getSize(); ++i) {
+        update(pq.at(i).playerID, QUEUED);
+    }
+    markIdsInFile(checkedInFilename, CHECKED_IN);
+
+    std::vector<const Player*> withdrawn;
+    withdrawals.collect(withdrawn);
+    for (size_t i = 0; i < withdrawn.size(); ++i) {
+        update(withdrawn[i]->playerID, WITHDRAWN);
+    }
+}
+
+// Flags the ID leading each "id,name,..." line of a log file. A missing file just
+// means nothing has been logged there yet; lines without a leading ID are ignored.
+void IdRegistry::markIdsInFile(const char* filename, int state) {
+    MappedFile file;
+    if (!file.open(filename)) {
+        return;
+    }
+    const char* cursor = file.data();
+    const char* end = cursor + file.size();
+    while (cursor < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(cursor, '\n', end - cursor));
+        if (lineEnd == nullptr) lineEnd = end;
+        const char* comma = static_cast<const char*>(memchr(cursor, ',', lineEnd - cursor));
+        FieldRange idField = { cursor, comma ? comma : lineEnd };
+        int id;
+        if (parseIntField(idField, id)) {
+            update(id, state);
+        }
+        cursor = lineEnd + 1;
+    }
+}
+
+IdRegistry& idRegistry() {
+    static IdRegistry registry;
+    return registry;
+}
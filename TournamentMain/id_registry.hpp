@@ -0,0 +1,54 @@
+#ifndef ID_REGISTRY_HPP
+#define ID_REGISTRY_HPP
+
+#include "id_index.hpp"
+
+class PriorityQueue;
+class WithdrawalStore;
+
+// Registration state of every player ID seen so far: queued (in players.txt / the
+// journal), checked in (checked_in.txt) and withdrawn (the withdrawal store).
+// Loaded once alongside the registration queue and updated by each registration
+// action, so ID validation never has to rescan the log files.
+class IdRegistry {
+public:
+    // State flags; an ID can carry several (e.g. checked in, then withdrawn)
+    enum State {
+        QUEUED = 1,
+        CHECKED_IN = 2,
+        WITHDRAWN = 4
+    };
+
+    // Rebuilds the registry from the queue, the check-in log and the withdrawal store
+    void load(const PriorityQueue& pq, const char* checkedInFilename, const WithdrawalStore& withdrawals);
+
+    // True if 'id' carries any of the flags in 'states'
+    bool has(int id, int states) const {
+        int current = idStates.find(id);
+        return current != -1 && (current & states) != 0;
+    }
+
+    // Adds 'set' and removes 'cleared' from the flags of 'id'
+    void update(int id, int set, int cleared = 0) {
+        int current = idStates.find(id);
+        int next = ((current == -1 ? 0 : current) & ~cleared) | set;
+        if (next == 0) {
+            idStates.erase(id);
+        }
+        else {
+            idStates.insert(id, next);
+        }
+    }
+
+    size_t size() const { return idStates.size(); }
+
+private:
+    IdIndex idStates; // Player ID -> State flags (IDs without flags are not stored)
+
+    void markIdsInFile(const char* filename, int state);
+};
+
+// The registry behind the registration files in the working directory
+IdRegistry& idRegistry();
+
+#endif // ID_REGISTRY_HPP
@@ -2,11 +2,15 @@
 #include <iostream>
 #include <limits> // Required for numeric_limits
 #include <cstdlib> // Required for system() for clearScreen()
+#include <cstring> // For strcmp (command-line flags)
+#include <fstream> // For batch scripts
 
 // Include headers that declare your task-specific main functions
 // You will need to create these headers if they don't exist,
 // or ensure your existing task headers declare these functions.
 #include "task_entry_points.hpp" // This header will declare Task1Main(), Task2Main(), etc.
+#include "batch_mode.hpp"
+#include "perf_stats.hpp" // Latency histograms for the statistics menu entry
 
 // Function to clear the console screen (cross-platform)
 void clearScreen() {
@@ -24,11 +28,29 @@ void displayOverallMainMenu() {
     std::cout << "2. Task 2: Tournament Registration & Player Queueing" << std::endl;
     std::cout << "3. Task 3: Live Stream & Spectator Queue Management" << std::endl;
     std::cout << "4. Task 4: Game Result Logging & Performance History" << std::endl;
+    std::cout << "5. Performance Statistics" << std::endl;
     std::cout << "0. Exit Application" << std::endl;
     std::cout << "Enter your choice: ";
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Batch mode: "--batch script.txt" runs a command script, "--batch" or "--batch -" reads stdin
+    if (argc >= 2 && strcmp(argv[1], "--batch") == 0) {
+        int failures;
+        if (argc >= 3 && strcmp(argv[2], "-") != 0) {
+            std::ifstream script(argv[2]);
+            if (!script.is_open()) {
+                std::cerr << "Error: Could not open batch script: " << argv[2] << std::endl;
+                return 1;
+            }
+            failures = runBatchMode(script);
+        }
+        else {
+            failures = runBatchMode(std::cin);
+        }
+        return failures == 0 ? 0 : 1;
+    }
+
     clearScreen(); // Clear screen at program start
 
     int choice;
@@ -70,6 +92,10 @@ int main() {
             Task4Main(); // Call the function for Task 4
             std::cout << "\nExiting Task 4. Returning to main menu.\n";
             break;
+        case 5:
+            clearScreen();
+            printPerfStats(std::cout); // Timings of everything run so far in this session
+            break;
         case 0:
             std::cout << "Exiting APUEC Championship Management System. Goodbye!" << std::endl;
             break;
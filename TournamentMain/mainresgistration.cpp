@@ -1,62 +1,49 @@
 #include <iostream>
-#include <fstream>
 #include <sstream>
 #include <string>
 #include <limits>
 #include "tournament_registration.hpp"
+#include "id_registry.hpp"
+#include "registration_import.hpp"
+#include "task_entry_points.hpp"
 
 using namespace std;
 
-bool isIdTaken(int id, PriorityQueue& pq) {
-    for (int i = 0; i < pq.size; ++i) {
-        if (pq.queue[i].id == id) return true;
-    }
-    return false;
+// ID checks answered by the in-memory registry (loaded with the queue), so validating
+// an ID never rescans withdrawals.txt or checked_in.txt
+bool isIdTaken(int id) {
+    return idRegistry().has(id, IdRegistry::QUEUED | IdRegistry::CHECKED_IN | IdRegistry::WITHDRAWN);
 }
 
 bool isIdInWithdrawals(int id) {
-    ifstream withdrawFile("withdrawals.txt");
-    if (!withdrawFile.is_open()) {
-        cout << "Error opening withdrawals.txt\n";
-        return false;
-    }
-    string line;
-    while (getline(withdrawFile, line)) {
-        stringstream ss(line);
-        string id_str;
-        getline(ss, id_str, ',');
-        int fileId = stoi(id_str);
-        if (fileId == id) {
-            withdrawFile.close();
-            return true;
-        }
-    }
-    withdrawFile.close();
-    return false;
+    return idRegistry().has(id, IdRegistry::WITHDRAWN);
 }
 
 bool isIdInCheckedIn(int id) {
-    ifstream checkedInFile("checked_in.txt");
-    if (!checkedInFile.is_open()) {
-        cout << "Error opening checked_in.txt\n";
-        return false;
+    return idRegistry().has(id, IdRegistry::CHECKED_IN);
+}
+
+// Returns why 'id' cannot be used for 'action', or nullptr if it can
+const char* idRejectionReason(const string& action, int id) {
+    if (action == "register") {
+        if (isIdTaken(id)) {
+            return "ID already used.";
+        }
+    }
+    else if (action == "check in") {
+        if (isIdInCheckedIn(id)) {
+            return "Player already checked in.";
+        }
     }
-    string line;
-    while (getline(checkedInFile, line)) {
-        stringstream ss(line);
-        string id_str;
-        getline(ss, id_str, ',');
-        int fileId = stoi(id_str);
-        if (fileId == id) {
-            checkedInFile.close();
-            return true;
+    else if (action == "withdraw") {
+        if (isIdInWithdrawals(id)) {
+            return "Player already withdrawn.";
         }
     }
-    checkedInFile.close();
-    return false;
+    return nullptr;
 }
 
-int getValidatedIdOrCancel(const string& action, PriorityQueue& pq) {
+int getValidatedIdOrCancel(const string& action) {
     int id;
     string input;
     while (true) {
@@ -65,23 +52,10 @@ int getValidatedIdOrCancel(const string& action, PriorityQueue& pq) {
         if (input == "c" || input == "C") return -1;
         try {
             id = stoi(input);
-            if (action == "register") {
-                if (isIdTaken(id, pq) || isIdInWithdrawals(id) || isIdInCheckedIn(id)) {
-                    cout << "ID already used. Enter a different ID.\n";
-                    continue;
-                }
-            }
-            else if (action == "check in") {
-                if (isIdInCheckedIn(id)) {
-                    cout << "Player already checked in. Enter different ID.\n";
-                    continue;
-                }
-            }
-            else if (action == "withdraw") {
-                if (isIdInWithdrawals(id)) {
-                    cout << "Player already withdrawn. Enter different ID.\n";
-                    continue;
-                }
+            const char* reason = idRejectionReason(action, id);
+            if (reason) {
+                cout << reason << " Enter a different ID.\n";
+                continue;
             }
             return id;
         }
@@ -91,6 +65,20 @@ int getValidatedIdOrCancel(const string& action, PriorityQueue& pq) {
     }
 }
 
+// Asks for a registration CSV and imports it, writing rejected rows to import_report.txt
+void importRegistrationsFromPrompt(PriorityQueue& pq) {
+    string filename;
+    cout << "Enter the registration CSV file name (id,name,regType per line) or 'c' to cancel: ";
+    getline(cin, filename);
+    filename = trim(filename);
+    if (filename.empty() || filename == "c" || filename == "C") {
+        cout << "Action canceled. Returning to menu.\n";
+        return;
+    }
+    ImportSummary summary;
+    importRegistrations(pq, filename.c_str(), "import_report.txt", summary);
+}
+
 void Task2Main() {
     PriorityQueue playerQueue;
 
@@ -111,7 +99,7 @@ void Task2Main() {
     cout << "   Date and Time: " << timeBuffer << "\n";
     cout << "========================================\n\n";
 
-    loadPlayersFromFile(playerQueue);
+    loadPlayersFromFile(playerQueue); // Also loads the ID registry used for validation
 
     int choice;
     do {
@@ -121,18 +109,19 @@ void Task2Main() {
         cout << "3. Withdraw Player\n";
         cout << "4. Replace Player\n";
         cout << "5. Display Queue\n";
-        cout << "6. Exit\n";
+        cout << "6. Import Registrations (CSV)\n";
+        cout << "7. Exit\n";
 
         while (!(cin >>choice)) {
             cout << "Enter your choice: ";
             if (!(cin >> choice)) {
-                cout << "Invalid input! Enter number 1-6.\n";
+                cout << "Invalid input! Enter number 1-7.\n";
                 cin.clear();
                 cin.ignore(numeric_limits<streamsize>::max(), '\n');
                 continue;
             }
-            if (choice < 1 || choice > 6) {
-                cout << "Please enter a valid option 1-6.\n";
+            if (choice < 1 || choice > 7) {
+                cout << "Please enter a valid option 1-7.\n";
                 cin.ignore(numeric_limits<streamsize>::max(), '\n');
                 continue;
             }
@@ -141,7 +130,7 @@ void Task2Main() {
         }
 
         if (choice == 1) {
-            int id = getValidatedIdOrCancel("register", playerQueue);
+            int id = getValidatedIdOrCancel("register");
             if (id == -1) {
                 cout << "Action canceled. Returning to menu.\n";
                 continue;
@@ -149,7 +138,7 @@ void Task2Main() {
             registerPlayer(playerQueue, id);
         }
         else if (choice == 2) {
-            int id = getValidatedIdOrCancel("check in", playerQueue);
+            int id = getValidatedIdOrCancel("check in");
             if (id == -1) {
                 cout << "Action canceled. Returning to menu.\n";
                 continue;
@@ -157,7 +146,7 @@ void Task2Main() {
             checkInPlayer(playerQueue, id);
         }
         else if (choice == 3) {
-            int id = getValidatedIdOrCancel("withdraw", playerQueue);
+            int id = getValidatedIdOrCancel("withdraw");
             if (id == -1) {
                 cout << "Action canceled. Returning to menu.\n";
                 continue;
@@ -171,12 +160,90 @@ void Task2Main() {
             displayPlayers(playerQueue);
         }
         else if (choice == 6) {
+            importRegistrationsFromPrompt(playerQueue);
+        }
+        else if (choice == 7) {
             cout << "Thank you for using the program. Goodbye!\n";
             cout << "Press Enter to exit...";
             cin.ignore(numeric_limits<streamsize>::max(), '\n');
             cin.get();
         }
-    } while (choice != 6);
+    } while (choice != 7);
 
     
 }
+
+// Registration queue shared by the batch commands, loaded from players.txt on first use
+PriorityQueue& batchPlayerQueue() {
+    static PriorityQueue playerQueue;
+    static bool loaded = false;
+    if (!loaded) {
+        loadPlayersFromFile(playerQueue);
+        loaded = true;
+    }
+    return playerQueue;
+}
+
+// Reads "<id> <regType> <name...>" for the register and replace commands
+bool readBatchPlayerDetails(istringstream& args, int& id, string& regType, string& name) {
+    if (!(args >> id >> regType)) {
+        return false;
+    }
+    getline(args, name);
+    name.erase(0, name.find_first_not_of(" \t"));
+    name.erase(name.find_last_not_of(" \t") + 1);
+    return !name.empty();
+}
+
+// Batch commands: register, checkin, withdraw, replace, import-players, list-players
+BatchStatus Task2BatchCommand(const string& command, istringstream& args) {
+    int id;
+    string regType, name;
+    if (command == "register" || command == "replace") {
+        if (!readBatchPlayerDetails(args, id, regType, name)) {
+            cerr << "Usage: " << command << " <id> <wildcard|earlybird|normal> <name>" << endl;
+            return BATCH_FAILED;
+        }
+        PriorityQueue& pq = batchPlayerQueue();
+        if (command == "register") {
+            const char* reason = idRejectionReason("register", id);
+            if (reason) {
+                cerr << "Cannot register player " << id << ": " << reason << endl;
+                return BATCH_FAILED;
+            }
+            return addPlayerRegistration(pq, id, name, regType) ? BATCH_DONE : BATCH_FAILED;
+        }
+        return completeReplacement(pq, id, name, regType) ? BATCH_DONE : BATCH_FAILED;
+    }
+    if (command == "checkin" || command == "withdraw") {
+        if (!(args >> id)) {
+            cerr << "Usage: " << command << " <id>" << endl;
+            return BATCH_FAILED;
+        }
+        PriorityQueue& pq = batchPlayerQueue();
+        const char* reason = idRejectionReason(command == "checkin" ? "check in" : "withdraw", id);
+        if (reason) {
+            cerr << "Cannot " << command << " player " << id << ": " << reason << endl;
+            return BATCH_FAILED;
+        }
+        bool done = command == "checkin" ? completeCheckIn(pq, id) : completeWithdrawal(pq, id);
+        return done ? BATCH_DONE : BATCH_FAILED;
+    }
+    if (command == "import-players") {
+        string csvFilename, reportFilename;
+        if (!(args >> csvFilename)) {
+            cerr << "Usage: import-players <csv file> [report file]" << endl;
+            return BATCH_FAILED;
+        }
+        if (!(args >> reportFilename)) {
+            reportFilename = "import_report.txt";
+        }
+        ImportSummary summary;
+        return importRegistrations(batchPlayerQueue(), csvFilename.c_str(), reportFilename.c_str(), summary) ? BATCH_DONE : BATCH_FAILED;
+    }
+    if (command == "list-players") {
+        printPlayerQueue(batchPlayerQueue());
+        return BATCH_DONE;
+    }
+    return BATCH_UNKNOWN;
+}
@@ -0,0 +1,121 @@
+#include "mapped_file.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>    // For open
+#include <sys/mman.h> // For mmap/munmap
+#include <sys/stat.h> // For fstat
+#include <unistd.h>   // For close
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile() : contents(nullptr), length(0), opened(false), fileHandle(nullptr), mappingHandle(nullptr) {}
+
+bool MappedFile::open(const char* filename) {
+    close();
+
+    HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    length = static_cast<size_t>(fileSize.QuadPart);
+    opened = true;
+    if (length == 0) {
+        return true; // Empty files cannot be mapped, but there is nothing to read anyway
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        close();
+        return false;
+    }
+    mappingHandle = mapping;
+
+    contents = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (contents == nullptr) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::close() {
+    if (contents != nullptr) {
+        UnmapViewOfFile(contents);
+    }
+    if (mappingHandle != nullptr) {
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+    }
+    if (fileHandle != nullptr) {
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+    }
+    contents = nullptr;
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+    length = 0;
+    opened = false;
+}
+
+#else
+
+MappedFile::MappedFile() : contents(nullptr), length(0), opened(false) {}
+
+bool MappedFile::open(const char* filename) {
+    close();
+
+    int fd = ::open(filename, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    length = static_cast<size_t>(info.st_size);
+    opened = true;
+    if (length == 0) {
+        ::close(fd);
+        return true; // Empty files cannot be mapped, but there is nothing to read anyway
+    }
+
+    void* view = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping stays valid after the descriptor is closed
+    if (view == MAP_FAILED) {
+        length = 0;
+        opened = false;
+        return false;
+    }
+    madvise(view, length, MADV_SEQUENTIAL);
+    contents = static_cast<const char*>(view);
+    return true;
+}
+
+void MappedFile::close() {
+    if (contents != nullptr) {
+        munmap(const_cast<char*>(contents), length);
+    }
+    contents = nullptr;
+    length = 0;
+    opened = false;
+}
+
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
@@ -0,0 +1,39 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef> // For size_t
+
+// Read-only memory mapping of a whole file.
+// The contents are exposed as one contiguous character range, so parsers can
+// tokenize the file in place without copying it through stream buffers.
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    // Maps the file; returns false if it cannot be opened or mapped.
+    // An existing but empty file opens successfully with size() == 0.
+    bool open(const char* filename);
+
+    // Unmaps the file (also done by the destructor)
+    void close();
+
+    const char* data() const { return contents; }
+    size_t size() const { return length; }
+    bool isOpen() const { return opened; }
+
+private:
+    const char* contents; // Start of the mapped view
+    size_t length;        // Size of the file in bytes
+    bool opened;          // True once open() succeeded
+#ifdef _WIN32
+    void* fileHandle;     // HANDLE from CreateFile
+    void* mappingHandle;  // HANDLE from CreateFileMapping
+#endif
+
+    // Mappings cannot be shared between owners
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+};
+
+#endif // MAPPED_FILE_HPP
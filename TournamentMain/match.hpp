@@ -3,8 +3,22 @@
 
 #include<iostream>
 #include<string>
+#include<vector>
+#include "node_pool.hpp"
 using namespace std;
 
+// Which part of the tournament a queued match belongs to
+enum MatchStage {
+    STAGE_GROUP,   // Group stage round robin
+    STAGE_SWISS,   // Swiss-system round
+    STAGE_KNOCKOUT // Knockout bracket match (only used for planning, the bracket keeps its own nodes)
+};
+
+// Name of a stage as written to the schedule files
+inline const char* matchStageName(MatchStage stage) {
+    return stage == STAGE_SWISS ? "Swiss" : stage == STAGE_KNOCKOUT ? "Knockout" : "GroupStage";
+}
+
 // Define the Match structure
 struct Match {
     int matchID;
@@ -12,13 +26,19 @@ struct Match {
     int player2ID;
     int winnerID; // 0 if not played, or PlayerID of the winner
     bool played;  // True if the match has concluded
+    int groupID;  // Group stage group this match belongs to (0 if none)
+    int round;    // Round within the group or Swiss round (0 if not round-based)
+    MatchStage stage; // Group stage, Swiss or knockout
     Match* next;  // Pointer to the next match in the circular queue
 
     // Constructor for easy initialization
-    Match(int id = 0, int p1 = 0, int p2 = 0) : matchID(id), player1ID(p1), player2ID(p2), winnerID(0), played(false), next(nullptr) {}
+    Match(int id = 0, int p1 = 0, int p2 = 0) : matchID(id), player1ID(p1), player2ID(p2), winnerID(0), played(false), groupID(0), round(0), stage(STAGE_GROUP), next(nullptr) {}
 };
 
 // Define the custom Circular Queue for Matches
+// Match nodes come from the queue's own slab pool: a stage's matches sit contiguously
+// in memory and are all released together by clear() or the destructor.
+// Match IDs are handed out sequentially, so a dense matchID -> node table gives O(1) lookups.
 class MatchQueue {
 public:
     Match* front; // Pointer to the front of the queue
@@ -26,25 +46,26 @@ public:
     int currentSize; // Tracks the number of matches in the queue
 
     // Constructor
-    MatchQueue() : front(nullptr), rear(nullptr), currentSize(0) {}
+    MatchQueue() : front(nullptr), rear(nullptr), currentSize(0), indexBase(0), matchPool(256) {}
 
-    // Destructor to free dynamically allocated Match nodes
-    ~MatchQueue() {
-        if (front == nullptr) return; // Queue is empty
+    // The pool frees every Match node in bulk, so no per-node teardown is needed
+    ~MatchQueue() {}
 
-        Match* current = front;
-        Match* temp;
-        // Iterate through the circular queue until we reach the front again
-        do {
-            temp = current->next;
-            delete current;
-            current = temp;
-        } while (current != front); // Stop when we loop back to the start
+    // Allocates a new Match from the queue's pool (it still has to be enqueued)
+    Match* createMatch(int id, int p1, int p2) {
+        return matchPool.create(id, p1, p2);
+    }
+
+    // Empties the queue and releases every Match node in one step
+    void clear() {
         front = nullptr;
         rear = nullptr;
+        currentSize = 0;
+        matchIndex.clear();
+        matchPool.reset();
     }
 
-    // Enqueues a new Match into the circular queue
+    // Enqueues a Match created by createMatch() into the circular queue
     void enqueue(Match* newMatch) {
         if (newMatch == nullptr) return; // Don't enqueue null
 
@@ -58,10 +79,12 @@ public:
             rear = newMatch;       // Update rear to new match
             rear->next = front;    // New rear points back to front to maintain circularity
         }
+        indexMatch(newMatch);
         currentSize++;
     }
 
-    // Dequeues a Match from the front of the circular queue
+    // Dequeues a Match from the front of the circular queue.
+    // The node stays owned by the pool and is released by the next clear().
     Match* dequeue() {
         if (front == nullptr) { // Queue is empty
             return nullptr;
@@ -77,6 +100,10 @@ public:
             rear->next = front;  // Maintain circularity by linking rear to new front
         }
         dequeuedMatch->next = nullptr; // Isolate the dequeued node
+        Match** slot = indexSlot(dequeuedMatch->matchID);
+        if (slot != nullptr && *slot == dequeuedMatch) {
+            *slot = nullptr; // No longer reachable through the queue
+        }
         currentSize--;
         return dequeuedMatch;
     }
@@ -96,6 +123,9 @@ public:
         std::cout << "Match Queue (" << currentSize << " matches):" << endl;
         do {
             std::cout << "  MatchID: " << current->matchID
+                << ", Stage: " << matchStageName(current->stage)
+                << ", Group: " << current->groupID
+                << ", Round: " << current->round
                 << ", Player1: " << current->player1ID
                 << ", Player2: " << current->player2ID
                 << ", Winner: " << (current->winnerID == 0 ? "N/A" : to_string(current->winnerID))
@@ -104,18 +134,39 @@ public:
         } while (current != front);
     }
 
-    // Gets a match by its ID (useful for updating results directly)
+    // Gets a match by its ID (useful for updating results directly) in O(1)
     Match* getMatchByID(int id) {
-        if (isEmpty()) return nullptr;
+        Match** slot = indexSlot(id);
+        return slot != nullptr ? *slot : nullptr;
+    }
 
-        Match* current = front;
-        do {
-            if (current->matchID == id) {
-                return current;
-            }
-            current = current->next;
-        } while (current != front);
-        return nullptr; // Match not found
+private:
+    std::vector<Match*> matchIndex; // matchIndex[matchID - indexBase] -> queued node, nullptr if absent
+    int indexBase;                  // matchID stored at matchIndex[0]
+    NodePool<Match> matchPool;      // Backing storage for every Match in this queue
+
+    // Returns the index entry for a match ID, or nullptr if the ID is outside the table
+    Match** indexSlot(int id) {
+        if (matchIndex.empty() || id < indexBase) return nullptr;
+        size_t offset = static_cast<size_t>(id - indexBase);
+        return offset < matchIndex.size() ? &matchIndex[offset] : nullptr;
+    }
+
+    // Records a newly enqueued match in the ID table, growing it as needed
+    void indexMatch(Match* match) {
+        if (matchIndex.empty()) {
+            indexBase = match->matchID;
+        }
+        else if (match->matchID < indexBase) {
+            // IDs normally only grow; shift the table if an older ID is enqueued
+            matchIndex.insert(matchIndex.begin(), static_cast<size_t>(indexBase - match->matchID), nullptr);
+            indexBase = match->matchID;
+        }
+        size_t offset = static_cast<size_t>(match->matchID - indexBase);
+        if (offset >= matchIndex.size()) {
+            matchIndex.resize(offset + 1, nullptr);
+        }
+        matchIndex[offset] = match;
     }
 };
 
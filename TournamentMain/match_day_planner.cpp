@@ -0,0 +1,86 @@
+#include "match_day_planner.hpp"
+#include "output_writer.hpp" // For writeFileAtomically
+#include <algorithm>     // For std::binary_search, std::upper_bound and std::sort
+#include <unordered_map>
+
+int MatchDayPlanner::plan(const std::vector<const Match*>& matches, int stationCount, int maxSlots) {
+    assignments.clear();
+    slotsUsed = 0;
+    unscheduled = 0;
+    if (stationCount < 1 || matches.empty()) return 0;
+
+    std::unordered_map<int, int> playerIndex;  // playerID -> dense index into busySlots
+    std::vector<std::vector<int>> busySlots;   // Sorted 0-based slots each player is already in
+    std::vector<int> stationsTaken;            // Matches placed per slot so far
+    int firstOpenSlot = 0;                     // Every slot before this one is full
+
+    auto indexOf = [&playerIndex, &busySlots](int playerID) {
+        std::unordered_map<int, int>::iterator found = playerIndex.find(playerID);
+        if (found != playerIndex.end()) return found->second;
+        int index = static_cast<int>(busySlots.size());
+        playerIndex[playerID] = index;
+        busySlots.emplace_back();
+        return index;
+    };
+    auto isBusy = [&busySlots](int player, int slot) {
+        const std::vector<int>& slots = busySlots[player];
+        return std::binary_search(slots.begin(), slots.end(), slot);
+    };
+    auto markBusy = [&busySlots](int player, int slot) {
+        std::vector<int>& slots = busySlots[player];
+        slots.insert(std::upper_bound(slots.begin(), slots.end(), slot), slot);
+    };
+
+    for (size_t i = 0; i < matches.size(); ++i) {
+        const Match* current = matches[i];
+        if (!current->played) {
+            int a = indexOf(current->player1ID);
+            int b = indexOf(current->player2ID);
+
+            // First fit: earliest slot with a free station where neither player is busy
+            int slot = firstOpenSlot;
+            while (slot < static_cast<int>(stationsTaken.size()) &&
+                (stationsTaken[slot] == stationCount || isBusy(a, slot) || isBusy(b, slot))) {
+                slot++;
+            }
+
+            if (maxSlots > 0 && slot >= maxSlots) {
+                unscheduled++; // The day is full for this pairing
+            }
+            else {
+                if (slot == static_cast<int>(stationsTaken.size())) {
+                    stationsTaken.push_back(0);
+                }
+                SlotAssignment assignment;
+                assignment.timeSlot = slot + 1;
+                assignment.station = ++stationsTaken[slot];
+                assignment.match = current;
+                assignments.push_back(assignment);
+                markBusy(a, slot);
+                markBusy(b, slot);
+
+                while (firstOpenSlot < static_cast<int>(stationsTaken.size()) && stationsTaken[firstOpenSlot] == stationCount) {
+                    firstOpenSlot++;
+                }
+            }
+        }
+    }
+
+    std::sort(assignments.begin(), assignments.end(), [](const SlotAssignment& x, const SlotAssignment& y) {
+        return x.timeSlot != y.timeSlot ? x.timeSlot < y.timeSlot : x.station < y.station;
+    });
+    slotsUsed = static_cast<int>(stationsTaken.size());
+    return slotsUsed;
+}
+
+bool MatchDayPlanner::writeSchedule(const char* filename) const {
+    std::string buffer;
+    for (size_t i = 0; i < assignments.size(); ++i) {
+        const SlotAssignment& a = assignments[i];
+        buffer += std::to_string(a.timeSlot) + "," + std::to_string(a.station) + "," +
+            std::to_string(a.match->matchID) + "," + std::to_string(a.match->player1ID) + "," +
+            std::to_string(a.match->player2ID) + "," + matchStageName(a.match->stage) + "," +
+            std::to_string(a.match->groupID) + "," + std::to_string(a.match->round) + "\n";
+    }
+    return writeFileAtomically(filename, buffer);
+}
@@ -0,0 +1,41 @@
+#ifndef MATCH_DAY_PLANNER_HPP
+#define MATCH_DAY_PLANNER_HPP
+
+#include <vector>
+#include "match.hpp"
+
+// Where and when one match is played on match day
+struct SlotAssignment {
+    int timeSlot; // 1-based time slot
+    int station;  // 1-based game station within the slot
+    const Match* match;
+};
+
+// Packs unplayed matches onto K game stations and T time slots.
+// Each slot runs at most K matches and no player appears twice in the same slot.
+// Matches are placed first-fit in the given order (queue order is round order), into the earliest
+// slot that has a free station and where neither player is already busy; this keeps
+// the number of slots close to the lower bound max(ceil(matches / K), most matches per player).
+class MatchDayPlanner {
+public:
+    MatchDayPlanner() : slotsUsed(0), unscheduled(0) {}
+
+    // Plans the given matches, which must outlive the plan. maxSlots limits the day
+    // (0 = no limit); matches that do not fit are left unscheduled. Returns the number of slots used.
+    int plan(const std::vector<const Match*>& matches, int stationCount, int maxSlots);
+
+    // Writes the plan slot by slot as CSV: slot,station,matchID,player1ID,player2ID,stage,group,round
+    // The file is replaced atomically.
+    bool writeSchedule(const char* filename) const;
+
+    const std::vector<SlotAssignment>& getAssignments() const { return assignments; }
+    int getSlotsUsed() const { return slotsUsed; }
+    int getUnscheduledCount() const { return unscheduled; }
+
+private:
+    std::vector<SlotAssignment> assignments; // Sorted by slot, then station
+    int slotsUsed;
+    int unscheduled;
+};
+
+#endif // MATCH_DAY_PLANNER_HPP
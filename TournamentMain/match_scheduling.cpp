@@ -2,54 +2,32 @@
 #include <fstream>
 #include <iostream>
 #include <string>
-#include <sstream> // For stringstream to parse lines
-#include <vector>  // Temporarily use for processedMatchIDs
+#include <vector>
+#include <algorithm> // For std::max and std::count
+#include <cstring>   // For memchr and strcmp
+#include "mapped_file.hpp"
+#include "group_stage.hpp"
+#include "monte_carlo.hpp"
+#include "perf_stats.hpp"
+#include "registration_journal.hpp"
+#include <random>    // For std::random_device (simulation seed)
+#include <chrono>    // For timing the simulation
 
 // --- Helper functions for parsing lines ---
-// Simple parsing for players.txt: PlayerID, Name, RegistrationTime, Status, Priority
-bool parsePlayerLine(const std::string& line, int& id, char* name, char* regTime, char* status, int& priority) {
-    std::stringstream ss(line);
-    std::string segment;
-    int current_segment = 0;
-
-    // Use getline with ',' as delimiter
-    while (std::getline(ss, segment, ',')) {
-        switch (current_segment) {
-        case 0: id = std::stoi(segment); break;
-        case 1: strncpy_s(name, 50, segment.c_str(), _TRUNCATE); break; // Use _TRUNCATE for automatic truncation
-        case 2: strncpy_s(regTime, 20, segment.c_str(), _TRUNCATE); break;
-        case 3: strncpy_s(status, 20, segment.c_str(), _TRUNCATE); break;
-        case 4: priority = std::stoi(segment); break;
-        default: return false; // Too many segments
-        }
-        current_segment++;
-    }
-    return current_segment == 5; // Ensure all 5 segments were parsed
-}
-
-// Simple parsing for results.txt: MatchID, WinnerID, LoserID
-bool parseResultLine(const std::string& line, int& matchID, int& winnerID, int& loserID) {
-    std::stringstream ss(line);
-    std::string segment;
-    int current_segment = 0;
-
-    while (std::getline(ss, segment, ',')) {
-        switch (current_segment) {
-        case 0: matchID = std::stoi(segment); break;
-        case 1: winnerID = std::stoi(segment); break;
-        case 2: loserID = std::stoi(segment); break;
-        default: return false;
-        }
-        current_segment++;
+// Parsing for one players.txt line, in the format shared with the registration module
+// (see parsePlayerLine); the player starts in group 0
+Player* parsePlayerRecord(const char* begin, const char* end) {
+    Player parsed;
+    if (!parsePlayerLine(begin, end, parsed)) {
+        return nullptr;
     }
-    return current_segment == 3;
+    return new Player(parsed);
 }
 
-
 // --- MatchScheduler Class Implementation ---
 
 // Constructor
-MatchScheduler::MatchScheduler() : nextMatchID(1) {
+MatchScheduler::MatchScheduler() : swissRound(0), nextMatchID(1), scheduleQueueRows(0) {
     // Constructor initializes internal data structures (done by their constructors)
     // nextMatchID ensures unique match IDs across all stages
 }
@@ -62,212 +40,566 @@ MatchScheduler::~MatchScheduler() {
 // === Public Interface Implementations ===
 
 // Reads player data from the specified file and populates the internal PlayerList.
+// The file is memory-mapped and tokenized in place, and every player is appended
+// in O(1), so the whole roster loads in a single linear pass.
 void MatchScheduler::loadPlayersFromFile(const char* players_filename) {
-    std::ifstream file(players_filename);
-    if (!file.is_open()) {
+    PERF_SCOPE("scheduler.loadPlayersFromFile");
+    // Registration keeps players.txt as a snapshot plus a journal; fold the journal in first
+    if (strcmp(players_filename, registrationJournal().getSnapshotFilename()) == 0) {
+        registrationJournal().sync();
+    }
+
+    MappedFile file;
+    if (!file.open(players_filename)) {
         std::cerr << "Error: Could not open players file: " << players_filename << std::endl;
         return;
     }
 
-    std::string line;
-    while (std::getline(file, line)) {
-        int id, priority;
-        char name[50], regTime[20], status[20];
-        if (parsePlayerLine(line, id, name, regTime, status, priority)) {
-            Player* newPlayer = new Player(id, name, regTime, status, priority, 0); // Group 0 for now
-            allPlayers.addPlayer(newPlayer);
-        }
-        else {
-            std::cerr << "Warning: Failed to parse player line: " << line << std::endl;
+    const char* cursor = file.data();
+    const char* end = cursor + file.size();
+
+    // Size the index and standings columns once instead of growing them per player
+    int expectedPlayers = allPlayers.getPlayerCount() + static_cast<int>(std::count(cursor, end, '\n')) + 1;
+    allPlayers.reserve(expectedPlayers);
+    standings.reserve(expectedPlayers);
+
+    int loaded = 0;
+    while (cursor < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+        if (lineEnd == nullptr) lineEnd = end;
+        const char* contentEnd = lineEnd;
+        if (contentEnd > cursor && contentEnd[-1] == '\r') --contentEnd; // Tolerate CRLF files
+
+        if (contentEnd > cursor && *cursor != '#') { // '#' lines are snapshot headers
+            Player* newPlayer = parsePlayerRecord(cursor, contentEnd);
+            if (newPlayer != nullptr) {
+                allPlayers.addPlayer(newPlayer);
+                standings.addPlayer(newPlayer);
+                loaded++;
+            }
+            else {
+                std::cerr << "Warning: Failed to parse player line: " << std::string(cursor, contentEnd) << std::endl;
+            }
         }
+        cursor = lineEnd + 1;
     }
-    file.close();
-    std::cout << "Loaded " << allPlayers.getPlayerCount() << " players from " << players_filename << std::endl;
+    PERF_COUNT("scheduler.playersLoaded", loaded);
+    std::cout << "Loaded " << loaded << " players from " << players_filename << std::endl;
 }
 
 // Processes new match results from the specified file.
 // This function should be called periodically by an external loop.
-// It assumes the results file might contain new entries since the last read.
+// Only lines appended since the previous call are parsed; the ingester keeps the
+// consumed offset and the processed match IDs, and persists them across restarts.
+// A result is only recorded as processed once it has been applied. Results for knockout
+// matches whose players are not known yet are kept and retried (in this call if other
+// results decided earlier rounds, otherwise on the next call); other results that cannot
+// be applied are dropped with a warning.
 void MatchScheduler::processMatchResultFile(const char* results_filename) {
-    // Use a static vector to store processed match IDs to avoid reprocessing
-    // This is a simple approach; for large files, a more efficient method
-    // like reading only new lines or using a hash set might be needed.
-    static std::vector<int> processedMatchIDs;
-
-    std::ifstream file(results_filename);
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open results file: " << results_filename << std::endl;
-        return;
+    PERF_SCOPE("scheduler.processMatchResultFile");
+    resultsFilename = results_filename;
+    int kept = 0;
+    bool retryKept = true;
+    while (retryKept) {
+        std::vector<ResultEntry> newResults; // Kept results first, then the newly appended ones
+        if (!resultIngester.readNewResults(results_filename, newResults)) {
+            std::cerr << "Error: Could not open results file: " << results_filename << std::endl;
+            return;
+        }
+        PERF_COUNT("scheduler.resultsIngested", newResults.size());
+
+        int applied = 0;
+        kept = 0;
+        for (size_t i = 0; i < newResults.size(); ++i) {
+            switch (applyMatchResult(newResults[i])) {
+            case RESULT_APPLIED:
+                resultIngester.confirmResult(newResults[i]);
+                applied++;
+                break;
+            case RESULT_NOT_READY:
+                resultIngester.deferResult(newResults[i]);
+                kept++;
+                break;
+            default:
+                break; // Dropped
+            }
+        }
+        resultIngester.commit();
+        retryKept = applied > 0 && kept > 0; // The applied results may have made kept ones playable
+    }
+    if (kept > 0) {
+        std::cout << kept << " knockout result(s) kept until the players of their matches are known." << std::endl;
     }
 
-    std::string line;
-    while (std::getline(file, line)) {
-        int matchID, winnerID, loserID;
-        if (parseResultLine(line, matchID, winnerID, loserID)) {
-            // Check if this matchID has already been processed
-            bool alreadyProcessed = false;
-            for (size_t i = 0; i < processedMatchIDs.size(); ++i) {
-                if (processedMatchIDs[i] == matchID) {
-                    alreadyProcessed = true;
-                    break;
-                }
-            }
+    // After processing results, update output files (only the changed rows are re-formatted,
+    // and files whose content did not change are not rewritten)
+    outputCurrentStandings("current_standings.txt");
+    outputScheduledMatches("scheduled_matches.txt"); // Knockout matches that became playable show up here
+}
 
-            if (!alreadyProcessed) {
-                // Find the match and update its winner/played status
-                Match* completedMatch = groupStageMatches.getMatchByID(matchID);
-                if (completedMatch) {
-                    completedMatch->winnerID = winnerID;
-                    completedMatch->played = true;
-                    std::cout << "Processed Group Stage Match: " << matchID << ", Winner: " << winnerID << std::endl;
-                }
-                else {
-                    // Check knockout stage if not found in group stage
-                    knockoutBracket.updateBracketWinner(matchID, winnerID);
-                    std::cout << "Processed Knockout Match: " << matchID << ", Winner: " << winnerID << std::endl;
-                }
-
-                // Update player statuses and wins/losses
-                updatePlayerStatsAndStatus(winnerID, loserID);
-
-                // Add to processed list
-                processedMatchIDs.push_back(matchID);
-            }
+// Applies one result to its match. Routed by stage: the bracket and the match queue
+// have disjoint ID ranges.
+MatchScheduler::ResultOutcome MatchScheduler::applyMatchResult(const ResultEntry& result) {
+    if (!isKnockoutMatchID(result.matchID)) {
+        Match* completedMatch = groupStageMatches.getMatchByID(result.matchID);
+        if (completedMatch == nullptr) {
+            std::cerr << "Warning: Match with ID " << result.matchID << " not found; result dropped." << std::endl;
+            return RESULT_REJECTED;
+        }
+        if (completedMatch->played) {
+            std::cerr << "Warning: Match " << result.matchID << " has already been played; result dropped." << std::endl;
+            return RESULT_REJECTED;
         }
-        else {
-            std::cerr << "Warning: Failed to parse result line: " << line << std::endl;
+        if (result.winnerID != completedMatch->player1ID && result.winnerID != completedMatch->player2ID) {
+            std::cerr << "Warning: Player " << result.winnerID << " is not playing in Match " << result.matchID
+                << "; result dropped." << std::endl;
+            return RESULT_REJECTED;
         }
+        completedMatch->winnerID = result.winnerID;
+        completedMatch->played = true;
+        markMatchChanged(result.matchID);
+        std::cout << "Processed Group Stage Match: " << result.matchID << ", Winner: " << result.winnerID << std::endl;
+
+        // Update player statuses and wins/losses
+        int loserID = result.winnerID == completedMatch->player1ID ? completedMatch->player2ID : completedMatch->player1ID;
+        updatePlayerStatsAndStatus(result.winnerID, loserID);
+        return RESULT_APPLIED;
     }
-    file.close();
 
-    // After processing results, update output files
-    outputCurrentStandings("current_standings.txt");
-    // You might also regenerate scheduled_matches.txt if new matches become available
-    // (e.g., in knockout stage as players advance)
+    // Knockout match: the winner moves into the parent match, which becomes ready
+    // once its other side is decided too
+    int slot = knockoutBracket.slotOfMatch(result.matchID);
+    const BracketNode& match = knockoutBracket.nodes[slot];
+    if (match.winnerID == 0 && (match.player1ID == 0 || match.player2ID == 0)) {
+        return RESULT_NOT_READY;
+    }
+    if (!knockoutBracket.updateBracketWinner(result.matchID, result.winnerID)) {
+        return RESULT_REJECTED; // Already decided or a wrong winner (warned about)
+    }
+    markMatchChanged(result.matchID);
+    std::cout << "Processed Knockout Match: " << result.matchID << ", Winner: " << result.winnerID << std::endl;
+    int loserID = match.player1ID == result.winnerID ? match.player2ID : match.player1ID;
+    updatePlayerStatsAndStatus(result.winnerID, loserID);
+    allPlayers.updatePlayerStatus(result.winnerID, slot == 1 ? STATUS_WINNER : STATUS_ADVANCED);
+    allPlayers.updatePlayerStatus(loserID, STATUS_ELIMINATED);
+    return RESULT_APPLIED;
 }
 
-// Generates group stage matches using a round-robin approach.
-void MatchScheduler::generateGroupStageMatches() {
-    // Clear any existing matches in the queue if regenerating
-    while (!groupStageMatches.isEmpty()) {
-        delete groupStageMatches.dequeue(); // Free memory
+// Appends one reported result to the results file, filling in the loser from the
+// scheduled match, and ingests it like any other new result.
+// Returns true only if the result was applied.
+bool MatchScheduler::submitMatchResult(const char* results_filename, int matchID, int winnerID) {
+    PERF_SCOPE("scheduler.submitMatchResult");
+    int player1ID = 0, player2ID = 0;
+    int slot = knockoutBracket.slotOfMatch(matchID);
+    Match* match = slot != 0 ? nullptr : groupStageMatches.getMatchByID(matchID);
+    if (match) {
+        if (match->played) {
+            std::cerr << "Warning: Match " << matchID << " has already been played." << std::endl;
+            return false;
+        }
+        player1ID = match->player1ID;
+        player2ID = match->player2ID;
     }
-
-    // Assign players to a default group if not already assigned
-    Player* current = allPlayers.head;
-    while (current != nullptr) {
-        if (current->groupID == 0) { // If group not set, assign to default group 1
-            current->groupID = 1;
+    else if (slot != 0) {
+        const BracketNode& node = knockoutBracket.nodes[slot];
+        if (node.winnerID != 0) {
+            std::cerr << "Warning: Knockout Match " << matchID << " has already been decided." << std::endl;
+            return false;
+        }
+        if (node.player1ID == 0 || node.player2ID == 0) {
+            std::cerr << "Warning: Knockout Match " << matchID << " is not ready; its players are not known yet." << std::endl;
+            return false;
         }
-        current = current->next;
+        player1ID = node.player1ID;
+        player2ID = node.player2ID;
+    }
+    else {
+        std::cerr << "Warning: Match with ID " << matchID << " not found." << std::endl;
+        return false;
+    }
+    if (winnerID == 0 || (winnerID != player1ID && winnerID != player2ID)) {
+        std::cerr << "Warning: Player " << winnerID << " is not playing in Match " << matchID << "." << std::endl;
+        return false;
     }
 
-    // Simple round-robin for all players in group 1 (for demonstration)
+    std::ofstream file(results_filename, std::ios_base::app);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open results file: " << results_filename << std::endl;
+        return false;
+    }
+    file << matchID << "," << winnerID << "," << (winnerID == player1ID ? player2ID : player1ID) << "\n";
+    file.close();
+
+    processMatchResultFile(results_filename);
+    bool applied = match ? match->played && match->winnerID == winnerID : knockoutBracket.nodes[slot].winnerID == winnerID;
+    if (!applied) {
+        std::cerr << "Warning: The result for Match " << matchID << " was not applied." << std::endl;
+    }
+    return applied;
+}
+
+// Starts result ingestion for the file from scratch, discarding its saved checkpoint
+void MatchScheduler::resetResultCheckpoint(const char* results_filename) {
+    resultsFilename = results_filename;
+    resultIngester.reset(results_filename);
+}
+
+// Results recorded for these IDs belonged to older matches (e.g. from before a restart),
+// so they must not count as processed for the new ones
+void MatchScheduler::forgetResultsForNewMatches(int firstID, int lastID) {
+    if (resultsFilename.empty() || firstID > lastID) return; // No results file attached yet
+    resultIngester.forgetProcessed(resultsFilename.c_str(), firstID, lastID);
+}
+
+// Generates group stage matches: players are snake-seeded by priority into numGroups
+// groups, and every group plays a circle-method round robin so nobody appears twice
+// in a round. Groups are generated in parallel; matches are queued round by round.
+void MatchScheduler::generateGroupStageMatches(int numGroups) {
+    PERF_SCOPE("scheduler.generateGroupStageMatches");
+    // Clear any existing matches in the queue if regenerating (one bulk release)
+    groupStageMatches.clear();
+    swissRound = 0; // Round robin groups replace any Swiss event
+    int firstNewID = nextMatchID;
+
     if (allPlayers.getPlayerCount() < 2) {
         std::cout << "Not enough players for group stage." << std::endl;
+        markScheduleLayoutChanged();
         return;
     }
+    numGroups = std::max(1, std::min(numGroups, allPlayers.getPlayerCount() / 2)); // At least 2 players per group
+
+    // Snake seeding: order by priority (stable), then deal 1..N, N..1, 1..N, ...
+    std::vector<int> seedOrder(static_cast<size_t>(standings.size()));
+    for (int slot = 0; slot < standings.size(); ++slot) {
+        seedOrder[slot] = slot;
+    }
+    std::stable_sort(seedOrder.begin(), seedOrder.end(), [this](int a, int b) {
+        return standings.priorities[a] > standings.priorities[b];
+    });
+
+    std::vector<std::vector<int>> groups(static_cast<size_t>(numGroups));
+    for (size_t i = 0; i < seedOrder.size(); ++i) {
+        int row = static_cast<int>(i) / numGroups;
+        int position = static_cast<int>(i) % numGroups;
+        int group = (row % 2 == 0) ? position : numGroups - 1 - position;
+        standings.setGroup(seedOrder[i], group + 1);
+        groups[group].push_back(standings.playerIDs[seedOrder[i]]);
+    }
 
-    Player* p1 = allPlayers.head;
-    while (p1 != nullptr) {
-        Player* p2 = p1->next; // Start from the next player to avoid self-play and duplicate pairs
-        while (p2 != nullptr) {
-            // Only create matches if both players are in the same group (if groups were more complex)
-            if (p1->groupID == p2->groupID) {
-                Match* newMatch = new Match(nextMatchID++, p1->playerID, p2->playerID);
+    std::vector<std::vector<GroupPairing>> pairings;
+    generateGroupRoundRobins(groups, pairings);
+
+    // Queue the matches round-major (round 1 of every group, then round 2, ...),
+    // assigning match IDs on this thread so numbering stays deterministic
+    std::vector<size_t> cursor(static_cast<size_t>(numGroups), 0);
+    int rounds = 0;
+    for (int round = 1; ; ++round) {
+        bool anyLeft = false;
+        for (int g = 0; g < numGroups; ++g) {
+            const std::vector<GroupPairing>& groupPairings = pairings[g];
+            while (cursor[g] < groupPairings.size() && groupPairings[cursor[g]].round == round) {
+                const GroupPairing& pairing = groupPairings[cursor[g]++];
+                Match* newMatch = groupStageMatches.createMatch(nextMatchID++, pairing.player1ID, pairing.player2ID);
+                newMatch->groupID = g + 1;
+                newMatch->round = round;
                 groupStageMatches.enqueue(newMatch);
             }
-            p2 = p2->next;
+            anyLeft = anyLeft || cursor[g] < groupPairings.size();
         }
-        p1 = p1->next;
+        rounds = round;
+        if (!anyLeft) break;
     }
-    std::cout << "Generated " << groupStageMatches.currentSize << " group stage matches." << std::endl;
+
+    forgetResultsForNewMatches(firstNewID, nextMatchID - 1);
+    std::cout << "Generated " << groupStageMatches.currentSize << " group stage matches in "
+        << numGroups << " group(s) over " << rounds << " round(s)." << std::endl;
+    markScheduleLayoutChanged();
     outputScheduledMatches("scheduled_matches.txt"); // Immediately output newly scheduled matches
 }
 
+// Generates the next Swiss round. The first call starts a new Swiss event (replacing any
+// group stage matches); later calls need every match of the previous round to be played.
+// Scores come from the standings wins; ratings (priority) break ties.
+void MatchScheduler::generateSwissRound() {
+    PERF_SCOPE("scheduler.generateSwissRound");
+    if (standings.size() < 2) {
+        std::cout << "Not enough players for a Swiss round." << std::endl;
+        return;
+    }
+
+    if (swissRound == 0 || swissEngine.getPlayerCount() != standings.size()) {
+        groupStageMatches.clear();
+        swissEngine.reset(standings.size());
+        swissRound = 0;
+    }
+    else if (!groupStageMatches.isEmpty()) {
+        Match* current = groupStageMatches.front;
+        do {
+            if (!current->played) {
+                std::cout << "Swiss round " << swissRound << " still has unplayed matches (e.g. Match "
+                    << current->matchID << "). Record all results first." << std::endl;
+                return;
+            }
+            current = current->next;
+        } while (current != groupStageMatches.front);
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<SwissPairing> pairings;
+    int rematches = swissEngine.pairRound(standings.wins, standings.priorities, pairings);
+    double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    swissRound++;
+
+    int matchCount = 0;
+    int firstNewID = nextMatchID;
+    for (size_t i = 0; i < pairings.size(); ++i) {
+        const SwissPairing& pairing = pairings[i];
+        if (pairing.player2 < 0) {
+            // The bye counts as a win
+            standings.recordWin(pairing.player1);
+            std::cout << "Player " << standings.playerIDs[pairing.player1] << " receives the bye in Swiss round " << swissRound << "." << std::endl;
+            continue;
+        }
+        Match* newMatch = groupStageMatches.createMatch(nextMatchID++, standings.playerIDs[pairing.player1], standings.playerIDs[pairing.player2]);
+        newMatch->round = swissRound;
+        newMatch->stage = STAGE_SWISS;
+        groupStageMatches.enqueue(newMatch);
+        matchCount++;
+    }
+
+    forgetResultsForNewMatches(firstNewID, nextMatchID - 1);
+
+    std::cout << "Generated Swiss round " << swissRound << ": " << matchCount << " matches, paired in "
+        << milliseconds << " ms." << std::endl;
+    if (rematches > 0) {
+        std::cerr << "Warning: " << rematches << " rematch(es) could not be avoided in Swiss round " << swissRound << "." << std::endl;
+    }
+    markScheduleLayoutChanged();
+    outputScheduledMatches("scheduled_matches.txt");
+}
+
 // Generates the knockout stage bracket based on group stage results.
-void MatchScheduler::generateKnockoutStageBracket() {
+// Any number of qualifiers is accepted; missing entrants become byes for the top seeds.
+void MatchScheduler::generateKnockoutStageBracket(int knockoutSize) {
+    PERF_SCOPE("scheduler.generateKnockoutStageBracket");
     // 1. Identify qualifying players based on group stage performance
     //    (e.g., top N players by wins, then by losses).
-    allPlayers.sortPlayersByRanking(); // Sorts players in place
-
-    // Create a temporary list of qualifiers
-    // For simplicity, let's take a fixed number of top players
-    PlayerList qualifiers;
-    Player* current = allPlayers.head;
-    int qualifiedCount = 0;
-    // Example: take top 8 players for knockout (needs 2^N players)
-    while (current != nullptr && qualifiedCount < 8) {
-        // Create a new Player object (copy data) for the qualifiers list
-        Player* qualifiedPlayer = new Player(current->playerID, current->name, current->registrationTime, current->status, current->priority, current->groupID);
-        qualifiers.addPlayer(qualifiedPlayer);
-        current = current->next;
-        qualifiedCount++;
-    }
-
-    if (qualifiers.getPlayerCount() < 2) {
+    //    Only the top handles are selected, the rest of the field is left unsorted.
+    std::vector<RankEntry> ranking;
+    standings.collectRankEntries(ranking); // Keys come from the bulk kernel over the stat columns
+    selectTopRankEntries(ranking, knockoutSize);
+
+    // Seed order is ranking order: the bracket only needs the IDs
+    std::vector<int> seededIDs;
+    seededIDs.reserve(ranking.size());
+    for (size_t i = 0; i < ranking.size(); ++i) {
+        seededIDs.push_back(ranking[i].player->playerID);
+    }
+
+    if (seededIDs.size() < 2) {
         std::cout << "Not enough players qualified for knockout stage." << std::endl;
-        // Clean up temporary qualifiers list
-        // This is handled by qualifiers destructor since it's a local object.
         return;
     }
 
     // 2. Build the knockout bracket using the qualified players
-    // This will reset the knockoutBracket and build it from the qualifiers.
-    if (knockoutBracket.root != nullptr) {
-        knockoutBracket.clearBracket(knockoutBracket.root);
-        knockoutBracket.root = nullptr;
-    }
-    knockoutBracket.nextBracketMatchID = 1001; // Reset match ID counter for bracket
-    knockoutBracket.buildBracket(&qualifiers); // Pass the qualifiers PlayerList
+    // This will reset the knockoutBracket and build it from the seeds.
+    // Its matches take the next block of IDs after the queued matches (the final is
+    // nextMatchID), so a result ID always belongs to exactly one stage.
+    knockoutBracket.matchIDBase = nextMatchID - 1;
+    knockoutBracket.buildBracket(seededIDs);
+    nextMatchID += knockoutBracket.leafCount - 1;
+    forgetResultsForNewMatches(knockoutBracket.matchIDBase + 1, nextMatchID - 1);
 
     std::cout << "Generated knockout stage bracket." << std::endl;
+    markScheduleLayoutChanged();
     outputScheduledMatches("scheduled_matches.txt"); // Output knockout matches
 }
 
 // Writes currently scheduled (unplayed) matches to an output file.
+// Lines are cached per match; only matches marked as changed are re-formatted, and the
+// file is replaced atomically, and only when its content actually changed.
 void MatchScheduler::outputScheduledMatches(const char* output_filename) {
-    std::ofstream file(output_filename);
-    if (!file.is_open()) {
+    PERF_SCOPE("scheduler.outputScheduledMatches");
+    scheduleOutput.refresh([this](size_t row, std::string& line) { formatScheduleRow(row, line); });
+    PublishResult result = scheduleOutput.publish(output_filename);
+    if (result == PUBLISH_FAILED) {
         std::cerr << "Error: Could not open output file: " << output_filename << std::endl;
+    }
+    else if (result == PUBLISH_WRITTEN) {
+        std::cout << "Scheduled matches written to " << output_filename << std::endl;
+    }
+    else {
+        std::cout << "Scheduled matches unchanged, " << output_filename << " not rewritten" << std::endl;
+    }
+}
+
+// Re-lays out the schedule rows after matches were generated: one row per queued match
+// (in queue order), then one row per knockout match slot, deepest round first.
+// Queued match IDs need not be consecutive (a bracket built between two Swiss rounds
+// takes IDs in between), so the rows are mapped through the queue itself.
+void MatchScheduler::markScheduleLayoutChanged() {
+    scheduleQueueMatches.clear();
+    scheduleQueueRowOf.clear();
+    if (!groupStageMatches.isEmpty()) {
+        scheduleQueueMatches.reserve(static_cast<size_t>(groupStageMatches.currentSize));
+        scheduleQueueRowOf.reserve(groupStageMatches.currentSize);
+        Match* current = groupStageMatches.front;
+        do {
+            scheduleQueueRowOf.insert(current->matchID, static_cast<int>(scheduleQueueMatches.size()));
+            scheduleQueueMatches.push_back(current);
+            current = current->next;
+        } while (current != groupStageMatches.front);
+    }
+    scheduleQueueRows = static_cast<int>(scheduleQueueMatches.size());
+    int knockoutRows = knockoutBracket.isEmpty() ? 0 : knockoutBracket.leafCount - 1;
+    scheduleOutput.resize(static_cast<size_t>(scheduleQueueRows + knockoutRows));
+}
+
+// Marks the schedule row(s) a decided match affects: the match itself and, for a
+// knockout match, the parent match its winner moved into
+void MatchScheduler::markMatchChanged(int matchID) {
+    if (!isKnockoutMatchID(matchID)) {
+        int queueRow = scheduleQueueRowOf.find(matchID);
+        if (queueRow != -1) {
+            scheduleOutput.markDirty(static_cast<size_t>(queueRow));
+        }
+        return;
+    }
+    int slot = knockoutBracket.slotOfMatch(matchID);
+    int leaves = knockoutBracket.leafCount;
+    auto markSlot = [this, leaves](int k) {
+        // Slots of one round are contiguous: the deeper rounds take leaves - 2 * levelStart rows
+        int levelStart = 1;
+        while (levelStart * 2 <= k) {
+            levelStart *= 2;
+        }
+        scheduleOutput.markDirty(static_cast<size_t>(scheduleQueueRows + (leaves - 2 * levelStart) + (k - levelStart)));
+    };
+    if (slot != 0) {
+        markSlot(slot);
+        if (slot > 1) markSlot(TournamentBracket::parentSlot(slot));
+    }
+}
+
+// Formats one schedule row: id,p1,p2,Stage,group,round for queued matches and
+// id,p1,p2,Knockout for ready knockout matches
+void MatchScheduler::formatScheduleRow(size_t row, std::string& line) {
+    if (static_cast<int>(row) < scheduleQueueRows) {
+        const Match* match = scheduleQueueMatches[row];
+        if (match->played) return; // Only write unplayed matches
+        line += std::to_string(match->matchID) + "," + std::to_string(match->player1ID) + "," +
+            std::to_string(match->player2ID) + "," + matchStageName(match->stage) + "," +
+            std::to_string(match->groupID) + "," + std::to_string(match->round) + "\n";
+        return;
+    }
+
+    // Knockout rows: walk down the rounds (deepest first) to find the slot
+    int offset = static_cast<int>(row) - scheduleQueueRows;
+    int levelSize = knockoutBracket.leafCount / 2;
+    while (levelSize > 0 && offset >= levelSize) {
+        offset -= levelSize;
+        levelSize /= 2;
+    }
+    int slot = levelSize + offset;
+    if (levelSize == 0 || !knockoutBracket.isReady(slot)) return; // Decided, or players not known yet
+    const BracketNode& match = knockoutBracket.nodes[slot];
+    line += std::to_string(knockoutBracket.matchIDOfSlot(slot)) + "," + std::to_string(match.player1ID) + "," +
+        std::to_string(match.player2ID) + ",Knockout\n";
+}
+
+// Assigns unplayed queue matches and the knockout matches whose players are known to
+// game stations and time slots and writes the plan.
+void MatchScheduler::planMatchDay(int stationCount, int maxSlots, const char* output_filename) {
+    PERF_SCOPE("scheduler.planMatchDay");
+    if (stationCount < 1) {
+        std::cout << "At least one game station is needed to plan the match day." << std::endl;
         return;
     }
 
-    // Write group stage matches
+    std::vector<const Match*> matches;
     if (!groupStageMatches.isEmpty()) {
         Match* current = groupStageMatches.front;
         do {
-            if (!current->played) { // Only write unplayed matches
-                file << current->matchID << "," << current->player1ID << "," << current->player2ID << ",GroupStage" << std::endl;
-            }
+            if (!current->played) matches.push_back(current);
             current = current->next;
         } while (current != groupStageMatches.front);
     }
+    // Ready knockout matches, earliest round first; the bracket has no Match nodes,
+    // so they are planned from temporary copies
+    std::vector<Match> knockoutMatches;
+    knockoutMatches.reserve(static_cast<size_t>(knockoutBracket.leafCount));
+    for (int levelSize = knockoutBracket.leafCount / 2; levelSize > 0; levelSize /= 2) {
+        for (int slot = levelSize; slot < 2 * levelSize; ++slot) {
+            if (!knockoutBracket.isReady(slot)) continue;
+            const BracketNode& node = knockoutBracket.nodes[slot];
+            knockoutMatches.push_back(Match(knockoutBracket.matchIDOfSlot(slot), node.player1ID, node.player2ID));
+            knockoutMatches.back().stage = STAGE_KNOCKOUT;
+        }
+    }
+    for (size_t i = 0; i < knockoutMatches.size(); ++i) {
+        matches.push_back(&knockoutMatches[i]);
+    }
+    if (matches.empty()) {
+        std::cout << "No matches to plan." << std::endl;
+        return;
+    }
 
-    // Write knockout stage matches (traverse the bracket to find unplayed matches)
-    // A robust implementation would involve traversing the `knockoutBracket.root`
-    // and identifying matches where `winnerID` is 0 but `player1ID` and `player2ID` are set.
+    MatchDayPlanner planner;
+    int slots = planner.plan(matches, stationCount, maxSlots);
+    if (!planner.writeSchedule(output_filename)) {
+        std::cerr << "Error: Could not open output file: " << output_filename << std::endl;
+        return;
+    }
 
-    file.close();
-    std::cout << "Scheduled matches written to " << output_filename << std::endl;
+    std::cout << "Planned " << planner.getAssignments().size() << " matches on " << stationCount
+        << " station(s) over " << slots << " time slot(s)." << std::endl;
+    if (planner.getUnscheduledCount() > 0) {
+        std::cout << "Warning: " << planner.getUnscheduledCount() << " match(es) did not fit in "
+            << maxSlots << " time slot(s) and were left unscheduled." << std::endl;
+    }
+    std::cout << "Match day schedule written to " << output_filename << std::endl;
 }
 
 // Writes current player standings to an output file.
 void MatchScheduler::outputCurrentStandings(const char* output_filename) {
-    std::ofstream file(output_filename);
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open output file: " << output_filename << std::endl;
-        return;
+    PERF_SCOPE("scheduler.outputCurrentStandings");
+    // Only rows whose stats or status changed since the last call are re-formatted
+    if (standingsOutput.rowCount() != static_cast<size_t>(standings.size())) {
+        standingsOutput.resize(static_cast<size_t>(standings.size()));
+    }
+    std::vector<int> changedSlots;
+    standings.takeChangedSlots(changedSlots);
+    for (size_t i = 0; i < changedSlots.size(); ++i) {
+        standingsOutput.markDirty(static_cast<size_t>(changedSlots[i]));
+    }
+    std::vector<Player*> changedPlayers;
+    allPlayers.takeStatusChanges(changedPlayers);
+    for (size_t i = 0; i < changedPlayers.size(); ++i) {
+        if (changedPlayers[i]->standingsSlot >= 0) {
+            standingsOutput.markDirty(static_cast<size_t>(changedPlayers[i]->standingsSlot));
+        }
     }
 
-    Player* current = allPlayers.head;
-    while (current != nullptr) {
-        file << current->playerID << "," << current->name << "," << current->status
-            << "," << current->wins << "," << current->losses << "," << current->groupID << std::endl;
-        current = current->next;
+    // Stats come from the standings columns; only name and status are read from the player node
+    standingsOutput.refresh([this](size_t row, std::string& line) {
+        int slot = static_cast<int>(row);
+        const Player* player = standings.handles[slot];
+        line += std::to_string(standings.playerIDs[slot]) + "," + player->getName() + "," + player->getStatusName() + "," +
+            std::to_string(standings.wins[slot]) + "," + std::to_string(standings.losses[slot]) + "," +
+            std::to_string(standings.groupIDs[slot]) + "\n";
+    });
+
+    PublishResult result = standingsOutput.publish(output_filename);
+    if (result == PUBLISH_FAILED) {
+        std::cerr << "Error: Could not open output file: " << output_filename << std::endl;
+    }
+    else if (result == PUBLISH_WRITTEN) {
+        std::cout << "Current standings written to " << output_filename << std::endl;
+    }
+    else {
+        std::cout << "Current standings unchanged, " << output_filename << " not rewritten" << std::endl;
     }
-    file.close();
-    std::cout << "Current standings written to " << output_filename << std::endl;
 }
 
 // === Private Helper Functions Implementation ===
@@ -276,21 +608,21 @@ void MatchScheduler::outputCurrentStandings(const char* output_filename) {
 void MatchScheduler::updatePlayerStatsAndStatus(int winnerPlayerID, int loserPlayerID) {
     Player* winner = allPlayers.getPlayerByID(winnerPlayerID);
     if (winner) {
-        winner->wins++;
+        standings.recordWin(winner->standingsSlot);
         // Update status for group stage players or those just advancing
-        if (strcmp(winner->status, "Playing") == 0 || strcmp(winner->status, "Registered") == 0) {
-            allPlayers.updatePlayerStatus(winnerPlayerID, "Advanced");
+        if (winner->status == STATUS_PLAYING || winner->status == STATUS_REGISTERED) {
+            allPlayers.updatePlayerStatus(winner, STATUS_ADVANCED);
         }
-        else if (strcmp(winner->status, "Finalist") == 0) {
-            allPlayers.updatePlayerStatus(winnerPlayerID, "Winner"); // If they won the final
+        else if (winner->status == STATUS_FINALIST) {
+            allPlayers.updatePlayerStatus(winner, STATUS_WINNER); // If they won the final
         }
     }
     Player* loser = allPlayers.getPlayerByID(loserPlayerID);
     if (loser) {
-        loser->losses++;
+        standings.recordLoss(loser->standingsSlot);
         // Update status for eliminated players
-        if (strcmp(loser->status, "Playing") == 0 || strcmp(loser->status, "Registered") == 0 || strcmp(loser->status, "Advanced") == 0) {
-            allPlayers.updatePlayerStatus(loserPlayerID, "Eliminated");
+        if (loser->status == STATUS_PLAYING || loser->status == STATUS_REGISTERED || loser->status == STATUS_ADVANCED) {
+            allPlayers.updatePlayerStatus(loser, STATUS_ELIMINATED);
         }
     }
 }
@@ -308,14 +640,48 @@ void MatchScheduler::displayGroupStageQueue() {
 void MatchScheduler::displayKnockoutBracket() {
     std::cout << "\n--- Tournament Knockout Bracket ---" << std::endl;
     // Pass the total number of players to enable correct round numbering
-    knockoutBracket.printBracket(knockoutBracket.root, allPlayers.getPlayerCount());
+    knockoutBracket.printBracket();
     // The printBracket now handles the closing line itself.
 }
 
+// Prints wins, losses and win percentage per group, then per player, from the standings store
+void MatchScheduler::displayGroupStandings() {
+    if (standings.size() == 0) {
+        std::cout << "No players loaded." << std::endl;
+        return;
+    }
+
+    std::vector<float> winPercentages(static_cast<size_t>(standings.size()));
+    standings.computeWinPercentages(winPercentages.data());
+
+    int maxGroup = 0;
+    for (int slot = 0; slot < standings.size(); ++slot) {
+        maxGroup = std::max(maxGroup, standings.groupIDs[slot]);
+    }
+
+    std::cout << "\n--- Group Standings ---" << std::endl;
+    for (int group = 0; group <= maxGroup; ++group) {
+        int groupWins = 0, groupLosses = 0;
+        standings.computeGroupTotals(group, groupWins, groupLosses);
+        if (groupWins == 0 && groupLosses == 0) continue; // Nothing played in this group yet
+
+        std::cout << "Group " << group << ": " << groupWins << " matches decided" << std::endl;
+        for (int slot = 0; slot < standings.size(); ++slot) {
+            if (standings.groupIDs[slot] != group) continue;
+            std::cout << "  ID: " << standings.playerIDs[slot]
+                << ", Name: " << standings.handles[slot]->getName()
+                << ", W/L: " << standings.wins[slot] << "/" << standings.losses[slot]
+                << ", Win%: " << winPercentages[slot] << std::endl;
+        }
+    }
+    std::cout << "-----------------------" << std::endl;
+}
+
 // --- Simulation Functions (for testing the independent operation) ---
 
 // Simulates group stage matches by randomly assigning winners
 void MatchScheduler::runGroupStageSimulation() {
+    PERF_SCOPE("scheduler.runGroupStageSimulation");
     std::cout << "\n--- Running Group Stage Simulation ---" << std::endl;
     // Collect all match IDs first to avoid modifying queue while iterating
     std::vector<int> matchIDsToSimulate;
@@ -342,6 +708,7 @@ void MatchScheduler::runGroupStageSimulation() {
             // Update internal state
             match->winnerID = winnerID;
             match->played = true;
+            markMatchChanged(match->matchID);
             updatePlayerStatsAndStatus(winnerID, loserID);
         }
     }
@@ -353,9 +720,43 @@ void MatchScheduler::runGroupStageSimulation() {
 
 // Simulates knockout stage matches
 void MatchScheduler::runKnockoutStageSimulation() {
+    PERF_SCOPE("scheduler.runKnockoutStageSimulation");
     // This will now call the robust simulation within TournamentBracket
     knockoutBracket.simulateKnockoutMatches(&allPlayers);
+    scheduleOutput.markAllDirty(); // Every knockout match may have been decided
 
     outputCurrentStandings("current_standings.txt");
     outputScheduledMatches("scheduled_matches.txt");
-}
\ No newline at end of file
+}
+
+// Monte Carlo outcome simulation over the current field and group assignment
+void MatchScheduler::runMonteCarloSimulation(long long tournamentCount, int knockoutSize, const char* output_filename) {
+    PERF_SCOPE("scheduler.runMonteCarloSimulation");
+    std::vector<MonteCarloEntrant> field(static_cast<size_t>(standings.size()));
+    for (int slot = 0; slot < standings.size(); ++slot) {
+        field[slot].playerID = standings.playerIDs[slot];
+        field[slot].groupID = standings.groupIDs[slot];
+        field[slot].priority = standings.priorities[slot];
+    }
+
+    MonteCarloSimulator simulator;
+    simulator.setEntrants(field);
+    std::random_device entropy;
+    std::uint64_t seed = (static_cast<std::uint64_t>(entropy()) << 32) ^ entropy();
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (!simulator.run(tournamentCount, knockoutSize, seed)) {
+        std::cout << "Not enough players (or tournaments) for a Monte Carlo simulation." << std::endl;
+        return;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "\n--- Monte Carlo Simulation: " << tournamentCount << " tournaments in " << seconds << " s ---" << std::endl;
+    simulator.writeReport(std::cout, 20); // Top 20 by win probability
+    if (simulator.writeCsv(output_filename)) {
+        std::cout << "Full simulation report written to " << output_filename << std::endl;
+    }
+    else {
+        std::cerr << "Error: Could not open output file: " << output_filename << std::endl;
+    }
+}
@@ -5,6 +5,12 @@
 #include "player.hpp"
 #include "match.hpp"
 #include "bracket.hpp"
+#include "standings.hpp"
+#include "result_ingester.hpp"
+#include "match_day_planner.hpp"
+#include "swiss.hpp"
+#include "output_writer.hpp"
+#include "id_index.hpp"
 
 // For file operations (fstream) and basic string/io (iostream, string)
 #include <fstream>
@@ -14,14 +20,37 @@
 class MatchScheduler {
 private:
     PlayerList allPlayers;          // Stores all registered players
+    StandingsStore standings;       // Columnar wins/losses/priority/group data for every player
+    ResultIngester resultIngester;  // Incremental, checkpointed reader for the results file
+    std::string resultsFilename;    // Results file the ingester is attached to ("" before the first use)
     MatchQueue groupStageMatches;   // Queue for group stage matches
-    TournamentBracket knockoutBracket; // Tree for knockout stage matches
+    TournamentBracket knockoutBracket; // Array-backed tree for knockout stage matches
+    SwissPairingEngine swissEngine; // Opponent/bye history for Swiss mode (indexed by standings slot)
+    int swissRound;                 // Swiss rounds generated so far (0 = not running Swiss)
     int nextMatchID;                // Counter for unique match IDs (across stages)
+    CachedOutputFile standingsOutput; // Cached standings lines, one row per standings slot
+    CachedOutputFile scheduleOutput;  // Cached schedule lines: queued matches, then knockout slots
+    std::vector<const Match*> scheduleQueueMatches; // Schedule row -> queued match, in queue order
+    IdIndex scheduleQueueRowOf;       // Queued match ID -> its schedule row (IDs can have gaps)
+    int scheduleQueueRows;            // Rows taken by the match queue; knockout rows follow
 
     // Private helper functions for internal logic and file writing
     void updatePlayerStatsAndStatus(int winnerPlayerID, int loserPlayerID); // Updates player wins/losses/status
     void writeScheduledMatchesToFile(const char* filename); // Writes current scheduled matches to a file
     void writeCurrentStandingsToFile(const char* filename); // Writes current player standings to a file
+    void markScheduleLayoutChanged();      // Matches were generated: every schedule row is re-laid out
+    void markMatchChanged(int matchID);    // A match was decided: re-format its schedule row(s)
+    bool isKnockoutMatchID(int matchID) const { return knockoutBracket.slotOfMatch(matchID) != 0; } // Bracket range, else queue
+
+    // What became of one ingested result
+    enum ResultOutcome {
+        RESULT_APPLIED,   // Recorded on its match
+        RESULT_NOT_READY, // Knockout match whose players are not known yet: keep it for later
+        RESULT_REJECTED   // Unknown match, already decided or wrong winner: drop it
+    };
+    ResultOutcome applyMatchResult(const ResultEntry& result);
+    void forgetResultsForNewMatches(int firstID, int lastID); // IDs [firstID, lastID] were just handed out
+    void formatScheduleRow(size_t row, std::string& line); // Text of one schedule row ("" if not scheduled)
 
 public:
     // Constructor and Destructor
@@ -33,24 +62,36 @@ public:
     // Input functions: Read data from external files
     void loadPlayersFromFile(const char* players_filename); // Reads initial player data from players.txt
     void processMatchResultFile(const char* results_filename); // Reads new match outcomes from results.txt
+    void resetResultCheckpoint(const char* results_filename);  // Forgets which results were already ingested
+    bool submitMatchResult(const char* results_filename, int matchID, int winnerID); // Appends one result (loser filled in) and ingests it
 
     // Core Task 1 functionalities: Generate matches based on internal state
-    void generateGroupStageMatches();      // Creates and schedules group stage matches
-    void generateKnockoutStageBracket();   // Builds the knockout bracket based on group stage results
+    void generateGroupStageMatches(int numGroups = 1); // Splits players into groups and schedules round-robin rounds
+    void generateKnockoutStageBracket(int knockoutSize = 8); // Builds the knockout bracket from the top knockoutSize players
+    void generateSwissRound();             // Pairs the next Swiss round from the current wins/losses
 
     // Output functions: Write current state to external files
     void outputScheduledMatches(const char* output_filename); // Writes matches currently ready to be played
     void outputCurrentStandings(const char* output_filename); // Writes the latest player standings/status
 
+    // Packs unplayed matches onto stations and time slots (no player double-booked)
+    // and writes the per-slot plan; maxSlots = 0 means the day has no slot limit
+    void planMatchDay(int stationCount, int maxSlots, const char* output_filename);
+
     // Simulation/Execution functions (if this task also "plays" matches internally for testing)
     // These functions would simulate match outcomes and then call processMatchResult internally
     void runGroupStageSimulation();
     void runKnockoutStageSimulation();
 
+    // Plays tournamentCount random group-plus-knockout tournaments on every core, with
+    // win chances from player priority, and reports each player's qualify/round/win odds
+    void runMonteCarloSimulation(long long tournamentCount, int knockoutSize, const char* output_filename);
+
     // Display functions (for debugging and demonstration purposes)
     void displayAllPlayers();
     void displayGroupStageQueue();
     void displayKnockoutBracket();
+    void displayGroupStandings();   // Per-group totals and win percentages from the standings store
 };
 
 #endif // TASK1_MATCH_SCHEDULING_HPP
\ No newline at end of file
@@ -0,0 +1,303 @@
+#include "monte_carlo.hpp"
+#include "group_stage.hpp" // Circle-method fixtures for each group
+#include "bracket.hpp"     // Standard seed placement (TournamentBracket::seedPosition)
+#include "ranking.hpp"     // Packed ranking keys
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <thread>
+
+namespace {
+
+// SplitMix64, used only to expand a single seed into the xoshiro state
+std::uint64_t splitMix64(std::uint64_t& x) {
+    std::uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+std::uint64_t rotateLeft(std::uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// Group stage rank of one entrant in one simulated tournament
+struct SimRank {
+    std::uint64_t key; // makeRankingKey(wins, losses, priority)
+    std::uint32_t tie; // Random tie-break between identical records
+    int index;         // Entrant index
+};
+
+} // namespace
+
+SimulationRng::SimulationRng(std::uint64_t seed) {
+    for (int i = 0; i < 4; ++i) {
+        state[i] = splitMix64(seed);
+    }
+}
+
+std::uint64_t SimulationRng::next() {
+    const std::uint64_t result = rotateLeft(state[1] * 5, 7) * 9;
+    const std::uint64_t t = state[1] << 17;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotateLeft(state[3], 45);
+    return result;
+}
+
+void SimulationRng::jump() {
+    static const std::uint64_t jumpPolynomial[4] = {
+        0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull, 0x39abdc4529b1661cull };
+    std::uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (int i = 0; i < 4; ++i) {
+        for (int b = 0; b < 64; ++b) {
+            if (jumpPolynomial[i] & (1ull << b)) {
+                s0 ^= state[0];
+                s1 ^= state[1];
+                s2 ^= state[2];
+                s3 ^= state[3];
+            }
+            next();
+        }
+    }
+    state[0] = s0;
+    state[1] = s1;
+    state[2] = s2;
+    state[3] = s3;
+}
+
+void MonteCarloSimulator::setEntrants(const std::vector<MonteCarloEntrant>& field) {
+    entrants = field;
+    int n = static_cast<int>(entrants.size());
+    strengths.resize(static_cast<size_t>(n));
+    for (int i = 0; i < n; ++i) {
+        strengths[i] = std::max(entrants[i].priority + 1, 1);
+    }
+
+    // Fixtures are the same in every tournament, only the outcomes change, so the
+    // round robins and each fixture's win threshold are computed once up front
+    std::map<int, std::vector<int>> groups; // groupID -> entrant index + 1 (0 is the bye)
+    for (int i = 0; i < n; ++i) {
+        groups[entrants[i].groupID].push_back(i + 1);
+    }
+    groupMatchA.clear();
+    groupMatchB.clear();
+    groupMatchThreshold.clear();
+    for (std::map<int, std::vector<int>>::const_iterator g = groups.begin(); g != groups.end(); ++g) {
+        std::vector<GroupPairing> pairings = generateCircleRoundRobin(g->second);
+        for (size_t m = 0; m < pairings.size(); ++m) {
+            int a = pairings[m].player1ID - 1;
+            int b = pairings[m].player2ID - 1;
+            double p = strengths[a] / (strengths[a] + strengths[b]);
+            groupMatchA.push_back(a);
+            groupMatchB.push_back(b);
+            groupMatchThreshold.push_back(p >= 1.0 ? UINT64_MAX : static_cast<std::uint64_t>(p * 18446744073709551616.0));
+        }
+    }
+
+    qualifyCounts.clear();
+    reachCounts.clear();
+    tournaments = 0;
+    knockoutLeaves = 0;
+    knockoutRounds = 0;
+}
+
+bool MonteCarloSimulator::run(long long tournamentCount, int knockoutSize, std::uint64_t seed, int threadCount) {
+    int n = static_cast<int>(entrants.size());
+    knockoutSize = std::min(knockoutSize, n);
+    if (knockoutSize < 2 || tournamentCount < 1) {
+        return false;
+    }
+
+    knockoutLeaves = 1;
+    knockoutRounds = 0;
+    while (knockoutLeaves < knockoutSize) {
+        knockoutLeaves <<= 1;
+        knockoutRounds++;
+    }
+
+    if (threadCount < 1) {
+        threadCount = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+    }
+    threadCount = static_cast<int>(std::min<long long>(threadCount, tournamentCount));
+
+    // One generator per thread, each 2^128 steps further along the same stream
+    std::vector<SimulationRng> rngs;
+    SimulationRng master(seed);
+    for (int t = 0; t < threadCount; ++t) {
+        rngs.push_back(master);
+        master.jump();
+    }
+
+    // Thread-private counters, merged once every share is done
+    std::vector<std::vector<long long>> qualified(static_cast<size_t>(threadCount));
+    std::vector<std::vector<long long>> reached(static_cast<size_t>(threadCount));
+
+    auto runShare = [&](int t) {
+        long long share = tournamentCount / threadCount + (t < tournamentCount % threadCount ? 1 : 0);
+        qualified[t].assign(static_cast<size_t>(n), 0);
+        reached[t].assign(static_cast<size_t>(knockoutRounds + 1) * n, 0);
+        simulateShare(share, rngs[t], knockoutSize, qualified[t], reached[t]);
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threadCount; ++t) {
+        workers.emplace_back(runShare, t);
+    }
+    runShare(0); // The calling thread takes the first share
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+
+    qualifyCounts.assign(static_cast<size_t>(n), 0);
+    reachCounts.assign(static_cast<size_t>(knockoutRounds + 1) * n, 0);
+    for (int t = 0; t < threadCount; ++t) {
+        for (size_t i = 0; i < qualifyCounts.size(); ++i) qualifyCounts[i] += qualified[t][i];
+        for (size_t i = 0; i < reachCounts.size(); ++i) reachCounts[i] += reached[t][i];
+    }
+    tournaments = tournamentCount;
+    return true;
+}
+
+void MonteCarloSimulator::simulateShare(long long count, SimulationRng& rng, int knockoutSize,
+    std::vector<long long>& qualified, std::vector<long long>& reached) const {
+    int n = static_cast<int>(entrants.size());
+    size_t fixtureCount = groupMatchA.size();
+    std::vector<int> wins(static_cast<size_t>(n));
+    std::vector<int> losses(static_cast<size_t>(n));
+    std::vector<SimRank> ranking(static_cast<size_t>(n));
+    std::vector<int> bracket(static_cast<size_t>(knockoutLeaves)); // Entrant index per slot, -1 = empty
+
+    for (long long run = 0; run < count; ++run) {
+        // Group stage: one draw per fixture
+        std::fill(wins.begin(), wins.end(), 0);
+        std::fill(losses.begin(), losses.end(), 0);
+        for (size_t m = 0; m < fixtureCount; ++m) {
+            int a = groupMatchA[m];
+            int b = groupMatchB[m];
+            if (rng.next() < groupMatchThreshold[m]) {
+                wins[a]++;
+                losses[b]++;
+            }
+            else {
+                wins[b]++;
+                losses[a]++;
+            }
+        }
+
+        // Qualification: top knockoutSize by record, exact ties decided at random
+        for (int i = 0; i < n; ++i) {
+            ranking[i].key = makeRankingKey(wins[i], losses[i], entrants[i].priority);
+            ranking[i].tie = static_cast<std::uint32_t>(rng.next() >> 32);
+            ranking[i].index = i;
+        }
+        std::partial_sort(ranking.begin(), ranking.begin() + knockoutSize, ranking.end(),
+            [](const SimRank& x, const SimRank& y) {
+                return x.key != y.key ? x.key > y.key : x.tie < y.tie;
+            });
+
+        std::fill(bracket.begin(), bracket.end(), -1);
+        for (int seed = 0; seed < knockoutSize; ++seed) {
+            int index = ranking[seed].index;
+            qualified[index]++;
+            bracket[TournamentBracket::seedPosition(seed, knockoutLeaves)] = index;
+        }
+
+        // Knockout: each round halves the slot array in place (winner of 2j and 2j+1 goes to j)
+        for (int round = 1, width = knockoutLeaves >> 1; round <= knockoutRounds; ++round, width >>= 1) {
+            for (int j = 0; j < width; ++j) {
+                int a = bracket[2 * j];
+                int b = bracket[2 * j + 1];
+                int winner;
+                if (a < 0 || b < 0) {
+                    winner = a < 0 ? b : a; // Bye
+                }
+                else {
+                    winner = rng.nextDouble() * (strengths[a] + strengths[b]) < strengths[a] ? a : b;
+                }
+                bracket[j] = winner;
+                if (winner >= 0) {
+                    reached[static_cast<size_t>(round) * n + winner]++;
+                }
+            }
+        }
+    }
+}
+
+double MonteCarloSimulator::qualifyProbability(int index) const {
+    return tournaments > 0 ? static_cast<double>(qualifyCounts[index]) / tournaments : 0.0;
+}
+
+double MonteCarloSimulator::reachProbability(int index, int roundsWon) const {
+    if (tournaments == 0 || roundsWon < 0 || roundsWon > knockoutRounds) return 0.0;
+    if (roundsWon == 0) return qualifyProbability(index);
+    return static_cast<double>(reachCounts[static_cast<size_t>(roundsWon) * entrants.size() + index]) / tournaments;
+}
+
+double MonteCarloSimulator::winProbability(int index) const {
+    return reachProbability(index, knockoutRounds);
+}
+
+std::string MonteCarloSimulator::roundLabel(int roundsWon) const {
+    int remaining = knockoutLeaves >> roundsWon;
+    if (remaining == 1) return "Win";
+    if (remaining == 2) return "Final";
+    if (remaining == 4) return "Semi";
+    return "Last" + std::to_string(remaining);
+}
+
+void MonteCarloSimulator::writeReport(std::ostream& out, int maxRows) const {
+    int n = static_cast<int>(entrants.size());
+    std::vector<int> order(static_cast<size_t>(n));
+    for (int i = 0; i < n; ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [this](int a, int b) {
+        if (winProbability(a) != winProbability(b)) return winProbability(a) > winProbability(b);
+        return qualifyProbability(a) > qualifyProbability(b);
+    });
+    int rows = (maxRows > 0) ? std::min(maxRows, n) : n;
+
+    out << std::setw(8) << "Player" << std::setw(10) << "Qualify";
+    for (int r = 1; r <= knockoutRounds; ++r) {
+        out << std::setw(10) << roundLabel(r);
+    }
+    out << std::endl;
+
+    std::ios::fmtflags oldFlags = out.flags();
+    std::streamsize oldPrecision = out.precision();
+    out << std::fixed << std::setprecision(2);
+    for (int row = 0; row < rows; ++row) {
+        int i = order[row];
+        out << std::setw(8) << entrants[i].playerID << std::setw(9) << qualifyProbability(i) * 100.0 << "%";
+        for (int r = 1; r <= knockoutRounds; ++r) {
+            out << std::setw(9) << reachProbability(i, r) * 100.0 << "%";
+        }
+        out << std::endl;
+    }
+    out.flags(oldFlags);
+    out.precision(oldPrecision);
+}
+
+bool MonteCarloSimulator::writeCsv(const char* filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << "playerID,qualify";
+    for (int r = 1; r <= knockoutRounds; ++r) {
+        file << "," << roundLabel(r);
+    }
+    file << "\n";
+    file << std::setprecision(6);
+    for (int i = 0; i < static_cast<int>(entrants.size()); ++i) {
+        file << entrants[i].playerID << "," << qualifyProbability(i);
+        for (int r = 1; r <= knockoutRounds; ++r) {
+            file << "," << reachProbability(i, r);
+        }
+        file << "\n";
+    }
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,84 @@
+#ifndef MONTE_CARLO_HPP
+#define MONTE_CARLO_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+
+// xoshiro256** generator. Every worker thread owns one; the streams are made
+// independent by jumping 2^128 steps ahead per thread from a common seed.
+class SimulationRng {
+public:
+    explicit SimulationRng(std::uint64_t seed);
+
+    std::uint64_t next();
+
+    // Uniform double in [0, 1)
+    double nextDouble() { return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0); }
+
+    // Advances the stream by 2^128 steps (one non-overlapping sub-stream per call)
+    void jump();
+
+private:
+    std::uint64_t state[4];
+};
+
+// One player taking part in the simulated tournaments
+struct MonteCarloEntrant {
+    int playerID;
+    int groupID;  // Group stage group (all entrants with the same ID play a round robin)
+    int priority; // Strength is priority + 1 (at least 1)
+};
+
+// Plays a tournament (group round robins, then a seeded knockout of the top K) many
+// times over with random outcomes. A match between strengths a and b goes to the first
+// player with probability a / (a + b) (Bradley-Terry). Each worker thread keeps its own
+// compact state: flat win counters, a rank buffer and a leaf array for the bracket.
+class MonteCarloSimulator {
+public:
+    MonteCarloSimulator() : tournaments(0), knockoutLeaves(0), knockoutRounds(0) {}
+
+    // Replaces the field of entrants (clears previous results)
+    void setEntrants(const std::vector<MonteCarloEntrant>& field);
+
+    // Runs tournamentCount tournaments over threadCount threads (0 = every core).
+    // knockoutSize players qualify; returns false if the field is too small.
+    bool run(long long tournamentCount, int knockoutSize, std::uint64_t seed, int threadCount = 0);
+
+    int getEntrantCount() const { return static_cast<int>(entrants.size()); }
+    long long getTournamentCount() const { return tournaments; }
+    int getKnockoutRounds() const { return knockoutRounds; }
+
+    // Probabilities for the entrant at 'index' (setEntrants order)
+    double qualifyProbability(int index) const;
+    double reachProbability(int index, int roundsWon) const; // Still in after winning roundsWon knockout rounds
+    double winProbability(int index) const;
+
+    // Writes a table sorted by win probability; maxRows = 0 writes every entrant
+    void writeReport(std::ostream& out, int maxRows) const;
+
+    // Writes every entrant as CSV: playerID,qualify, then one column per knockout round (the last is Win)
+    bool writeCsv(const char* filename) const;
+
+private:
+    std::vector<MonteCarloEntrant> entrants;
+    std::vector<double> strengths;       // Per entrant
+    std::vector<int> groupMatchA;        // Group stage fixtures as entrant index pairs
+    std::vector<int> groupMatchB;
+    std::vector<std::uint64_t> groupMatchThreshold; // A wins when a random 64-bit draw is below this
+    std::vector<long long> qualifyCounts; // Per entrant
+    std::vector<long long> reachCounts;   // [roundsWon * entrants + index], roundsWon in 1..knockoutRounds
+    long long tournaments;
+    int knockoutLeaves;
+    int knockoutRounds;
+
+    // Simulates 'count' tournaments, adding into the given (thread-private) counters
+    void simulateShare(long long count, SimulationRng& rng, int knockoutSize,
+        std::vector<long long>& qualified, std::vector<long long>& reached) const;
+
+    // Label of the column for entrants still in after 'roundsWon' rounds
+    std::string roundLabel(int roundsWon) const;
+};
+
+#endif // MONTE_CARLO_HPP
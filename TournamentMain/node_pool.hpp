@@ -0,0 +1,83 @@
+#ifndef NODE_POOL_HPP
+#define NODE_POOL_HPP
+
+#include <vector>      // Block table
+#include <new>         // For placement new and ::operator new
+#include <utility>     // For std::forward
+#include <type_traits> // For std::is_trivially_destructible
+#include <cstddef>     // For size_t
+
+// Slab pool for fixed-type nodes (Match, ...).
+// Nodes are carved sequentially out of large blocks, so nodes created together sit
+// next to each other in memory. Nodes are never freed one by one: reset() releases
+// every node at once and keeps the blocks for the next round of allocations, and the
+// destructor returns the blocks to the heap.
+template <typename T>
+class NodePool {
+    // reset() skips destructors, so only plain node types may be pooled
+    static_assert(std::is_trivially_destructible<T>::value, "NodePool only holds trivially destructible nodes");
+
+public:
+    explicit NodePool(size_t firstBlockSize = 64) : firstBlockCapacity(firstBlockSize), currentBlock(0), usedInBlock(0), liveCount(0) {}
+
+    ~NodePool() {
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            ::operator delete(blocks[i].storage);
+        }
+    }
+
+    // Constructs a new node in the pool and returns it
+    template <typename... Args>
+    T* create(Args&&... args) {
+        if (currentBlock == blocks.size() || usedInBlock == blocks[currentBlock].capacity) {
+            nextBlock();
+        }
+        T* node = new (blocks[currentBlock].storage + usedInBlock) T(std::forward<Args>(args)...);
+        usedInBlock++;
+        liveCount++;
+        return node;
+    }
+
+    // Releases every node at once; the blocks are kept and reused by later create() calls
+    void reset() {
+        currentBlock = 0;
+        usedInBlock = 0;
+        liveCount = 0;
+    }
+
+    // Number of nodes created since the last reset
+    size_t size() const { return liveCount; }
+
+private:
+    struct Block {
+        T* storage;      // Raw, uninitialized memory for 'capacity' nodes
+        size_t capacity; // Number of nodes the block can hold
+    };
+
+    std::vector<Block> blocks;
+    size_t firstBlockCapacity; // Capacity of the first block; each new block doubles it
+    size_t currentBlock;       // Block currently being filled
+    size_t usedInBlock;        // Nodes handed out from the current block
+    size_t liveCount;          // Nodes handed out since the last reset
+
+    // Moves to the next block, allocating it if the pool has never grown this far
+    void nextBlock() {
+        if (currentBlock < blocks.size() && usedInBlock > 0) {
+            currentBlock++;
+        }
+        usedInBlock = 0;
+        if (currentBlock == blocks.size()) {
+            size_t capacity = blocks.empty() ? firstBlockCapacity : blocks.back().capacity * 2;
+            Block block;
+            block.storage = static_cast<T*>(::operator new(capacity * sizeof(T)));
+            block.capacity = capacity;
+            blocks.push_back(block);
+        }
+    }
+
+    // Pools own their blocks and cannot be copied
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+};
+
+#endif // NODE_POOL_HPP
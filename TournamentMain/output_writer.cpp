@@ -0,0 +1,89 @@
+#include "output_writer.hpp"
+#include <fstream>
+#include <filesystem> // For the atomic rename and the size/write time checks
+#include <system_error>
+
+bool writeFileAtomically(const char* filename, const std::string& contents) {
+    std::string tempName = std::string(filename) + ".tmp";
+    {
+        // Unbuffered stream: the whole buffer goes to the OS in one write call
+        std::ofstream file;
+        file.rdbuf()->pubsetbuf(nullptr, 0);
+        file.open(tempName.c_str(), std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        if (!file) {
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempName, filename, error); // Replaces the old file in one step
+    if (error) {
+        std::filesystem::remove(tempName, error);
+        return false;
+    }
+    return true;
+}
+
+void CachedOutputFile::resize(size_t rowCount) {
+    if (rowCount != lines.size()) {
+        lines.resize(rowCount);
+        contentChanged = true;
+    }
+    allDirty = true;
+    dirtyRows.clear();
+    dirtyFlags.assign(rowCount, 0);
+}
+
+void CachedOutputFile::markDirty(size_t row) {
+    if (allDirty || row >= lines.size() || dirtyFlags[row]) {
+        return;
+    }
+    dirtyFlags[row] = 1;
+    dirtyRows.push_back(row);
+}
+
+void CachedOutputFile::markAllDirty() {
+    allDirty = true;
+    dirtyRows.clear();
+    dirtyFlags.assign(lines.size(), 0);
+}
+
+bool CachedOutputFile::isPublishedFileIntact(const char* filename) const {
+    if (publishedTo != filename) return false;
+    std::error_code error;
+    std::uintmax_t size = std::filesystem::file_size(filename, error);
+    if (error || size != publishedSize) return false; // Missing, or rewritten by another writer
+    std::filesystem::file_time_type time = std::filesystem::last_write_time(filename, error);
+    return !error && time == publishedTime;
+}
+
+PublishResult CachedOutputFile::publish(const char* filename) {
+    if (!contentChanged && isPublishedFileIntact(filename)) {
+        return PUBLISH_UNCHANGED; // Nothing changed since the last write
+    }
+
+    size_t total = 0;
+    for (size_t row = 0; row < lines.size(); ++row) {
+        total += lines[row].size();
+    }
+    std::string buffer;
+    buffer.reserve(total);
+    for (size_t row = 0; row < lines.size(); ++row) {
+        buffer += lines[row];
+    }
+
+    if (!writeFileAtomically(filename, buffer)) {
+        return PUBLISH_FAILED;
+    }
+    contentChanged = false;
+    publishedTo = filename;
+    std::error_code error;
+    publishedSize = buffer.size();
+    publishedTime = std::filesystem::last_write_time(filename, error);
+    if (error) publishedTo.clear(); // Cannot tell later whether the file is intact: always rewrite
+    return PUBLISH_WRITTEN;
+}
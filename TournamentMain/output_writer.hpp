@@ -0,0 +1,90 @@
+#ifndef OUTPUT_WRITER_HPP
+#define OUTPUT_WRITER_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <filesystem> // For the published file's write time
+
+// Replaces 'filename' with 'contents' atomically: the data goes to a temp file next to
+// it in a single write, and the temp file is then renamed over the target, so readers
+// never see a half-written file. Returns false if the file could not be written.
+bool writeFileAtomically(const char* filename, const std::string& contents);
+
+// Outcome of CachedOutputFile::publish()
+enum PublishResult {
+    PUBLISH_WRITTEN,   // The file was rewritten
+    PUBLISH_UNCHANGED, // Nothing changed since the last write, the file was left alone
+    PUBLISH_FAILED     // The file could not be written
+};
+
+// A line-oriented output file whose rows are formatted once and cached.
+// Callers mark the rows whose source data changed; refresh() re-formats only those,
+// and publish() rewrites the file only if some cached line actually changed, or the file
+// is missing or was modified by someone else since it was published (its size or write
+// time differs), so unchanged state costs no write at all.
+class CachedOutputFile {
+public:
+    CachedOutputFile() : allDirty(true), contentChanged(true), publishedSize(0) {}
+
+    // Sets the number of rows; every row is re-formatted on the next refresh
+    void resize(size_t rowCount);
+
+    // Marks one row for re-formatting
+    void markDirty(size_t row);
+
+    // Marks every row for re-formatting
+    void markAllDirty();
+
+    size_t rowCount() const { return lines.size(); }
+
+    // Re-formats the dirty rows: format(row, line) fills 'line' with the row's text
+    // (including its newline, or empty to leave the row out of the file)
+    template <typename Formatter>
+    void refresh(Formatter format) {
+        std::string line;
+        if (allDirty) {
+            for (size_t row = 0; row < lines.size(); ++row) {
+                line.clear();
+                format(row, line);
+                storeLine(row, line);
+            }
+        }
+        else {
+            for (size_t i = 0; i < dirtyRows.size(); ++i) {
+                size_t row = dirtyRows[i];
+                dirtyFlags[row] = 0;
+                line.clear();
+                format(row, line);
+                storeLine(row, line);
+            }
+        }
+        dirtyRows.clear();
+        allDirty = false;
+    }
+
+    // Writes the cached lines to filename if they changed since the last publish to it
+    PublishResult publish(const char* filename);
+
+private:
+    std::vector<std::string> lines;  // Cached formatted text per row
+    std::vector<char> dirtyFlags;    // Per row: already queued in dirtyRows
+    std::vector<size_t> dirtyRows;   // Rows to re-format on the next refresh
+    bool allDirty;                   // Every row must be re-formatted
+    bool contentChanged;             // Some line differs from what was last published
+    std::string publishedTo;         // File the current content was last written to
+    std::uintmax_t publishedSize;    // Its size and write time right after that write
+    std::filesystem::file_time_type publishedTime;
+
+    // True if 'filename' is still exactly the file the last publish() wrote
+    bool isPublishedFileIntact(const char* filename) const;
+
+    void storeLine(size_t row, std::string& line) {
+        if (lines[row] != line) {
+            lines[row].swap(line);
+            contentChanged = true;
+        }
+    }
+};
+
+#endif // OUTPUT_WRITER_HPP
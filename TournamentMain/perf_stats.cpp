@@ -0,0 +1,131 @@
+#include "perf_stats.hpp"
+#include <iomanip> // For setw and setprecision
+#include <sstream>
+#include <string>
+#include <cmath>   // For ceil
+
+bool perfStatsEnabled = true;
+
+// Heads of the registration lists, function-local so that stats constructed during
+// static initialization in other files never see them uninitialized
+static PerfStat*& perfStatList() {
+    static PerfStat* head = nullptr;
+    return head;
+}
+
+static PerfCounter*& perfCounterList() {
+    static PerfCounter* head = nullptr;
+    return head;
+}
+
+void LatencyHistogram::reset() {
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        buckets[i] = 0;
+    }
+    count = 0;
+    total = 0;
+    maxValue = 0;
+}
+
+std::uint64_t LatencyHistogram::bucketUpperBound(int index) {
+    if (index < SUB_BUCKETS) return static_cast<std::uint64_t>(index);
+    int exponent = index / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+    int subBucket = index % SUB_BUCKETS;
+    int shift = exponent - SUB_BUCKET_BITS;
+    std::uint64_t lower = static_cast<std::uint64_t>(SUB_BUCKETS + subBucket) << shift;
+    return lower + ((1ULL << shift) - 1);
+}
+
+std::uint64_t LatencyHistogram::valueAtPercentile(double percentile) const {
+    if (count == 0) return 0;
+    std::uint64_t target = static_cast<std::uint64_t>(std::ceil(static_cast<double>(count) * percentile / 100.0));
+    if (target < 1) target = 1;
+    if (target > count) target = count;
+
+    std::uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets[i];
+        if (seen >= target) {
+            std::uint64_t bound = bucketUpperBound(i);
+            return bound < maxValue ? bound : maxValue;
+        }
+    }
+    return maxValue;
+}
+
+// Stats and counters are appended, so the dump lists them in the order they were first used
+PerfStat::PerfStat(const char* statName) : name(statName), next(nullptr) {
+    PerfStat** link = &perfStatList();
+    while (*link != nullptr) link = &(*link)->next;
+    *link = this;
+}
+
+PerfCounter::PerfCounter(const char* counterName) : name(counterName), value(0), next(nullptr) {
+    PerfCounter** link = &perfCounterList();
+    while (*link != nullptr) link = &(*link)->next;
+    *link = this;
+}
+
+// Formats a nanosecond duration with a unit that keeps it short (ns, us, ms or s)
+static std::string formatDuration(std::uint64_t nanoseconds) {
+    std::ostringstream text;
+    if (nanoseconds < 1000) {
+        text << nanoseconds << " ns";
+    }
+    else if (nanoseconds < 1000000) {
+        text << std::fixed << std::setprecision(1) << nanoseconds / 1e3 << " us";
+    }
+    else if (nanoseconds < 1000000000) {
+        text << std::fixed << std::setprecision(2) << nanoseconds / 1e6 << " ms";
+    }
+    else {
+        text << std::fixed << std::setprecision(2) << nanoseconds / 1e9 << " s";
+    }
+    return text.str();
+}
+
+void printPerfStats(std::ostream& out) {
+    out << "--- Performance Statistics" << (perfStatsEnabled ? "" : " (recording off)") << " ---" << std::endl;
+    out << std::left << std::setw(40) << "Operation" << std::right
+        << std::setw(8) << "Calls"
+        << std::setw(12) << "p50"
+        << std::setw(12) << "p99"
+        << std::setw(12) << "Max"
+        << std::setw(12) << "Total" << std::endl;
+
+    int shown = 0;
+    for (PerfStat* stat = perfStatList(); stat != nullptr; stat = stat->next) {
+        const LatencyHistogram& h = stat->histogram;
+        if (h.getCount() == 0) continue; // Registered but never called since the last reset
+        out << std::left << std::setw(40) << stat->name << std::right
+            << std::setw(8) << h.getCount()
+            << std::setw(12) << formatDuration(h.valueAtPercentile(50.0))
+            << std::setw(12) << formatDuration(h.valueAtPercentile(99.0))
+            << std::setw(12) << formatDuration(h.getMax())
+            << std::setw(12) << formatDuration(h.getTotal()) << std::endl;
+        shown++;
+    }
+    if (shown == 0) {
+        out << "(no operations recorded yet)" << std::endl;
+    }
+
+    bool counterHeader = false;
+    for (PerfCounter* counter = perfCounterList(); counter != nullptr; counter = counter->next) {
+        if (counter->value == 0) continue;
+        if (!counterHeader) {
+            out << "Counters:" << std::endl;
+            counterHeader = true;
+        }
+        out << "  " << std::left << std::setw(38) << counter->name << std::right << std::setw(8) << counter->value << std::endl;
+    }
+    out << "------------------------------------" << std::endl;
+}
+
+void resetPerfStats() {
+    for (PerfStat* stat = perfStatList(); stat != nullptr; stat = stat->next) {
+        stat->histogram.reset();
+    }
+    for (PerfCounter* counter = perfCounterList(); counter != nullptr; counter = counter->next) {
+        counter->value = 0;
+    }
+}
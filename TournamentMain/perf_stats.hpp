@@ -0,0 +1,144 @@
+#ifndef PERF_STATS_HPP
+#define PERF_STATS_HPP
+
+#include <cstdint>
+#include <chrono>
+#include <iostream>
+
+// Lightweight instrumentation for the module entry points: per-operation latency
+// histograms and plain event counters, dumped by printPerfStats() (the main menu's
+// "Performance Statistics" entry and the batch "stats" command).
+// Recording is meant for the main thread; worker threads are timed as one operation
+// by whoever started them.
+
+// HDR-style latency histogram over nanoseconds. Values below 16 get a bucket each;
+// above that every power of two is split into 16 linear sub-buckets, so any recorded
+// value is known to within 1/16 (6.25%) with a fixed 720-bucket table and O(1) recording.
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 4;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const int MAX_EXPONENT = 47;  // Values are clamped to 2^48 ns (about 78 hours)
+    static const int BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+    LatencyHistogram() { reset(); }
+
+    // Clears every bucket
+    void reset();
+
+    // Adds one value (in nanoseconds)
+    void record(std::uint64_t value) {
+        buckets[bucketIndex(value)]++;
+        count++;
+        total += value;
+        if (value > maxValue) maxValue = value;
+    }
+
+    // Smallest value v such that at least 'percentile' percent of the recorded values
+    // fall in buckets up to v's bucket (reported as that bucket's upper bound, capped at max)
+    std::uint64_t valueAtPercentile(double percentile) const;
+
+    std::uint64_t getCount() const { return count; }
+    std::uint64_t getTotal() const { return total; }
+    std::uint64_t getMax() const { return maxValue; }
+
+    // Bucket that holds 'value'
+    static int bucketIndex(std::uint64_t value) {
+        if (value < static_cast<std::uint64_t>(SUB_BUCKETS)) return static_cast<int>(value);
+        int exponent = 63 - countLeadingZeros(value); // Position of the highest set bit
+        if (exponent > MAX_EXPONENT) return BUCKET_COUNT - 1;
+        int subBucket = static_cast<int>(value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+        return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + subBucket;
+    }
+
+    // Largest value that lands in bucket 'index'
+    static std::uint64_t bucketUpperBound(int index);
+
+private:
+    std::uint64_t buckets[BUCKET_COUNT];
+    std::uint64_t count;    // Values recorded
+    std::uint64_t total;    // Sum of the values (for the mean)
+    std::uint64_t maxValue; // Exact largest value
+
+    static int countLeadingZeros(std::uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_clzll(value);
+#else
+        int zeros = 0;
+        for (std::uint64_t bit = 1ULL << 63; (value & bit) == 0; bit >>= 1) zeros++;
+        return zeros;
+#endif
+    }
+};
+
+// A named latency histogram. Instances are created once (normally as function-local
+// statics through PERF_SCOPE) and link themselves into the list printPerfStats() walks.
+class PerfStat {
+public:
+    explicit PerfStat(const char* statName);
+
+    const char* name;
+    LatencyHistogram histogram;
+    PerfStat* next; // Next registered stat
+};
+
+// A named event counter (players loaded, results processed, ...)
+class PerfCounter {
+public:
+    explicit PerfCounter(const char* counterName);
+
+    void add(std::uint64_t amount) { value += amount; }
+
+    const char* name;
+    std::uint64_t value;
+    PerfCounter* next; // Next registered counter
+};
+
+// Recording switch; when off, timers skip the clock reads entirely
+extern bool perfStatsEnabled;
+
+// Times the enclosing scope into a PerfStat
+class ScopedTimer {
+public:
+    explicit ScopedTimer(PerfStat& target) : stat(target), active(perfStatsEnabled) {
+        if (active) start = std::chrono::steady_clock::now();
+    }
+
+    ~ScopedTimer() {
+        if (active) {
+            std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+            stat.histogram.record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+    }
+
+private:
+    PerfStat& stat;
+    bool active;
+    std::chrono::steady_clock::time_point start;
+
+    ScopedTimer(const ScopedTimer&);
+    ScopedTimer& operator=(const ScopedTimer&);
+};
+
+// Prints calls, p50, p99, max and total time per operation, then the counters
+void printPerfStats(std::ostream& out);
+
+// Clears every histogram and counter
+void resetPerfStats();
+
+#define PERF_CONCAT_INNER(a, b) a##b
+#define PERF_CONCAT(a, b) PERF_CONCAT_INNER(a, b)
+
+// Times the rest of the enclosing scope under 'name' (a string literal)
+#define PERF_SCOPE(name) \
+    static PerfStat PERF_CONCAT(perfStat_, __LINE__)(name); \
+    ScopedTimer PERF_CONCAT(perfTimer_, __LINE__)(PERF_CONCAT(perfStat_, __LINE__))
+
+// Adds 'amount' to the counter 'name' (a string literal)
+#define PERF_COUNT(name, amount) \
+    do { \
+        static PerfCounter perfCounter(name); \
+        if (perfStatsEnabled) perfCounter.add(static_cast<std::uint64_t>(amount)); \
+    } while (0)
+
+#endif // PERF_STATS_HPP
@@ -0,0 +1,51 @@
+#ifndef PLATFORM_COMPAT_HPP
+#define PLATFORM_COMPAT_HPP
+
+// Portability shim for the MSVC-specific CRT functions the modules use.
+// On Windows the real functions are used; elsewhere they are provided here with the
+// same truncating, always null-terminated behaviour.
+
+#ifdef _WIN32
+#include <direct.h> // For _getcwd
+#else
+#include <unistd.h> // For getcwd
+#include <cstring>  // For strlen and memcpy
+#include <cstddef>  // For size_t
+
+#ifndef _TRUNCATE
+#define _TRUNCATE (static_cast<size_t>(-1))
+#endif
+
+// Copies at most 'count' characters of src (all of it with _TRUNCATE) into dest, cutting
+// the copy to fit destSize - 1 characters; dest is always null-terminated
+inline int strncpy_s(char* dest, size_t destSize, const char* src, size_t count) {
+    if (dest == nullptr || destSize == 0) return 1;
+    size_t length = strlen(src);
+    if (count != _TRUNCATE && length > count) length = count;
+    if (length >= destSize) length = destSize - 1;
+    memcpy(dest, src, length);
+    dest[length] = '\0';
+    return 0;
+}
+
+// Array form: the destination size comes from the array type
+template <size_t Size>
+inline int strncpy_s(char (&dest)[Size], const char* src, size_t count) {
+    return strncpy_s(dest, Size, src, count);
+}
+
+inline int strcpy_s(char* dest, size_t destSize, const char* src) {
+    return strncpy_s(dest, destSize, src, _TRUNCATE);
+}
+
+template <size_t Size>
+inline int strcpy_s(char (&dest)[Size], const char* src) {
+    return strncpy_s(dest, Size, src, _TRUNCATE);
+}
+
+inline char* _getcwd(char* buffer, int size) {
+    return getcwd(buffer, static_cast<size_t>(size));
+}
+#endif // _WIN32
+
+#endif // PLATFORM_COMPAT_HPP
@@ -1,30 +1,96 @@
 #ifndef PLAYER_HPP
 #define PLAYER_HPP
 
-// No need for _CRT_SECURE_NO_WARNINGS if using _s functions
 #include <iostream> // For basic input/output like std::cout
-#include <cstring>  // For string manipulation functions like strncpy_s, strcmp
 #include <string>   // For std::string usage, if preferred over char arrays for some parts
+#include <vector>   // Backing storage for the player ID index
+#include "player_record.hpp" // The Player record shared with the registration module
+#include "ranking.hpp" // Packed-key ranking handles used by sortPlayersByRanking
+
+// Open-addressing hash index from playerID to the Player node that owns it.
+// Linear probing over a power-of-two table keeps every lookup O(1) on average,
+// so the linked list never has to be walked to find a player by ID.
+// Each bucket stores the ID next to the pointer, so probing never touches the nodes.
+class PlayerIndex {
+public:
+    PlayerIndex() : used(0) {}
+
+    // Removes every entry but keeps the allocated table
+    void clear() {
+        for (size_t i = 0; i < slots.size(); ++i) {
+            slots[i].player = nullptr;
+        }
+        used = 0;
+    }
+
+    // Makes room for at least 'count' players without rehashing
+    void reserve(int count) {
+        size_t wanted = 16;
+        while (wanted < static_cast<size_t>(count) * 2) {
+            wanted <<= 1;
+        }
+        if (wanted > slots.size()) {
+            rehash(wanted);
+        }
+    }
+
+    // Adds or replaces the node stored for player->playerID
+    void insert(Player* player) {
+        if ((used + 1) * 2 > slots.size()) {
+            rehash(slots.empty() ? 16 : slots.size() * 2);
+        }
+        size_t i = probeStart(player->playerID);
+        while (slots[i].player != nullptr) {
+            if (slots[i].id == player->playerID) {
+                slots[i].player = player;
+                return;
+            }
+            i = (i + 1) & (slots.size() - 1);
+        }
+        slots[i].id = player->playerID;
+        slots[i].player = player;
+        used++;
+    }
 
-// Define the Player structure (Node for the linked list)
-struct Player {
-    int playerID;
-    char name[50];
-    char registrationTime[20]; // YYYY-MM-DD HH:MM:SS format
-    char status[20];          // e.g., "Registered", "Playing", "Eliminated", "Advanced", "Winner"
-    int priority;             // For initial seeding/ranking
-    int groupID;              // To assign players to specific groups for group stage
-    int wins;                 // Tracks wins in group stage (or overall)
-    int losses;               // Tracks losses in group stage (or overall)
-    Player* next;             // Pointer to the next player in the list
-
-    // Constructor for easy initialization
-    Player(int id = 0, const char* n = "", const char* regTime = "", const char* s = "", int p = 0, int g = 0)
-        : playerID(id), priority(p), groupID(g), wins(0), losses(0), next(nullptr) {
-        // Use strncpy_s instead of strncpy
-        strncpy_s(name, sizeof(name), n, sizeof(name) - 1);
-        strncpy_s(registrationTime, sizeof(registrationTime), regTime, sizeof(registrationTime) - 1);
-        strncpy_s(status, sizeof(status), s, sizeof(status) - 1);
+    // Returns the node for the given ID, or nullptr if it is not indexed
+    Player* find(int id) const {
+        if (slots.empty()) return nullptr;
+        size_t i = probeStart(id);
+        while (slots[i].player != nullptr) {
+            if (slots[i].id == id) {
+                return slots[i].player;
+            }
+            i = (i + 1) & (slots.size() - 1);
+        }
+        return nullptr;
+    }
+
+private:
+    struct Bucket {
+        int id;         // Key, valid only when player is set
+        Player* player; // nullptr marks an empty bucket
+    };
+
+    std::vector<Bucket> slots;
+    size_t used; // Number of occupied buckets
+
+    // Fibonacci hashing spreads sequential IDs across the table
+    size_t probeStart(int id) const {
+        unsigned long long h = static_cast<unsigned int>(id) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(h >> 32) & (slots.size() - 1);
+    }
+
+    void rehash(size_t newSize) {
+        std::vector<Bucket> old;
+        old.swap(slots);
+        Bucket empty = { 0, nullptr };
+        slots.assign(newSize, empty);
+        used = 0;
+        for (size_t i = 0; i < old.size(); ++i) {
+            if (old[i].player != nullptr) {
+                insert(old[i].player);
+            }
+        }
     }
 };
 
@@ -32,10 +98,13 @@ struct Player {
 class PlayerList {
 public:
     Player* head; // Pointer to the first player in the list
+    Player* tail; // Pointer to the last player, so appends do not walk the list
     int playerCount; // Number of players in the list
+    PlayerIndex idIndex; // playerID -> node, kept in sync with the list
+    std::vector<Player*> statusChanges; // Players whose status changed since the last takeStatusChanges()
 
     // Constructor
-    PlayerList() : head(nullptr), playerCount(0) {}
+    PlayerList() : head(nullptr), tail(nullptr), playerCount(0) {}
 
     // Destructor to free dynamically allocated Player nodes
     ~PlayerList() {
@@ -46,97 +115,101 @@ public:
             current = nextPlayer;
         }
         head = nullptr; // Ensure head is null after deletion
+        tail = nullptr;
+    }
+
+    // Pre-sizes the ID index for a bulk load of 'count' players
+    void reserve(int count) {
+        idIndex.reserve(count);
     }
 
-    // Adds a new Player node to the end of the list
+    // Adds a new Player node to the end of the list in O(1)
     void addPlayer(Player* newPlayer) {
         if (newPlayer == nullptr) return;
 
+        newPlayer->next = nullptr;
         if (head == nullptr) {
             head = newPlayer;
         }
         else {
-            Player* current = head;
-            while (current->next != nullptr) {
-                current = current->next;
-            }
-            current->next = newPlayer;
+            tail->next = newPlayer;
         }
+        tail = newPlayer;
+        idIndex.insert(newPlayer);
         playerCount++;
     }
 
-    // Retrieves a Player by their ID
+    // Retrieves a Player by their ID (constant time through the ID index)
     Player* getPlayerByID(int id) {
-        Player* current = head;
-        while (current != nullptr) {
-            if (current->playerID == id) {
-                return current;
-            }
-            current = current->next;
-        }
-        return nullptr; // Player not found
+        return idIndex.find(id);
     }
 
     // Updates the status of a Player
-    void updatePlayerStatus(int id, const char* newStatus) {
+    void updatePlayerStatus(int id, PlayerStatus newStatus) {
         Player* player = getPlayerByID(id);
         if (player != nullptr) {
-            // Use strncpy_s instead of strncpy
-            strncpy_s(player->status, sizeof(player->status), newStatus, sizeof(player->status) - 1);
+            updatePlayerStatus(player, newStatus);
         }
         else {
             std::cerr << "Warning: Player with ID " << id << " not found for status update." << std::endl;
         }
     }
 
+    // Updates the status of a Player that has already been looked up
+    void updatePlayerStatus(Player* player, PlayerStatus newStatus) {
+        if (player->status == newStatus) return; // No change
+        player->status = newStatus;
+        if (!player->statusChanged) {
+            player->statusChanged = true;
+            statusChanges.push_back(player);
+        }
+    }
+
+    // Moves the players whose status changed since the previous call into 'out'
+    void takeStatusChanges(std::vector<Player*>& out) {
+        out.clear();
+        out.swap(statusChanges);
+        for (size_t i = 0; i < out.size(); ++i) {
+            out[i]->statusChanged = false;
+        }
+    }
+
     // Returns the total number of players
     int getPlayerCount() const {
         return playerCount;
     }
 
-    // Simple Bubble Sort implementation to sort players by their group stage performance
-    // (e.g., by wins, then by losses, then by priority for tie-breaking)
+    // Fills 'out' with one ranking handle per player, in list order
+    void collectRankEntries(std::vector<RankEntry>& out) {
+        out.clear();
+        out.reserve(static_cast<size_t>(playerCount));
+        int order = 0;
+        for (Player* current = head; current != nullptr; current = current->next) {
+            RankEntry entry;
+            entry.key = makeRankingKey(current->wins, current->losses, current->priority);
+            entry.order = order++;
+            entry.player = current;
+            out.push_back(entry);
+        }
+    }
+
+    // Sorts players by their group stage performance
+    // (higher wins, then lower losses, then higher priority for tie-breaking).
+    // Sorts packed-key handles in O(n log n) and relinks the nodes in the new order,
+    // so player payloads never move and the ID index stays valid.
     void sortPlayersByRanking() {
         if (head == nullptr || head->next == nullptr) return; // 0 or 1 player, already sorted
 
-        bool swapped;
-        Player* current;
-        Player* last = nullptr; // Tracks the last sorted element
-
-        do {
-            swapped = false;
-            current = head;
-            while (current->next != last) {
-                // Example sorting criteria: higher wins, then lower losses
-                bool shouldSwap = false;
-                if (current->wins < current->next->wins) {
-                    shouldSwap = true;
-                }
-                else if (current->wins == current->next->wins && current->losses > current->next->losses) {
-                    shouldSwap = true;
-                }
-                else if (current->wins == current->next->wins && current->losses == current->next->losses && current->priority < current->next->priority) {
-                    shouldSwap = true; // Use priority as tie-breaker
-                }
-
-                if (shouldSwap) {
-                    // Swap data of current and current->next nodes
-                    // Use strcpy_s instead of strcpy for character arrays
-                    int tempID = current->playerID; current->playerID = current->next->playerID; current->next->playerID = tempID;
-                    char tempName[50]; strcpy_s(tempName, sizeof(tempName), current->name); strcpy_s(current->name, sizeof(current->name), current->next->name); strcpy_s(current->next->name, sizeof(current->next->name), tempName);
-                    char tempRegTime[20]; strcpy_s(tempRegTime, sizeof(tempRegTime), current->registrationTime); strcpy_s(current->registrationTime, sizeof(current->registrationTime), current->next->registrationTime); strcpy_s(current->next->registrationTime, sizeof(current->next->registrationTime), tempRegTime);
-                    char tempStatus[20]; strcpy_s(tempStatus, sizeof(tempStatus), current->status); strcpy_s(current->status, sizeof(current->status), current->next->status); strcpy_s(current->next->status, sizeof(current->next->status), tempStatus);
-                    int tempPriority = current->priority; current->priority = current->next->priority; current->next->priority = tempPriority;
-                    int tempGroup = current->groupID; current->groupID = current->next->groupID; current->next->groupID = tempGroup;
-                    int tempWins = current->wins; current->wins = current->next->wins; current->next->wins = tempWins;
-                    int tempLosses = current->losses; current->losses = current->next->losses; current->next->losses = tempLosses;
-
-                    swapped = true;
-                }
-                current = current->next;
-            }
-            last = current; // After each pass, the last element is sorted
-        } while (swapped);
+        std::vector<RankEntry> ranking;
+        collectRankEntries(ranking);
+        sortRankEntries(ranking);
+
+        head = ranking[0].player;
+        for (size_t i = 0; i + 1 < ranking.size(); ++i) {
+            ranking[i].player->next = ranking[i + 1].player;
+        }
+        tail = ranking.back().player;
+        tail->next = nullptr;
     }
 
     // Prints details of all players (for debugging/display)
@@ -149,9 +222,9 @@ public:
         Player* current = head;
         while (current != nullptr) {
             std::cout << "ID: " << current->playerID
-                << ", Name: " << current->name
-                << ", RegTime: " << current->registrationTime
-                << ", Status: " << current->status
+                << ", Name: " << current->getName()
+                << ", RegTime: " << formatRegistrationTime(current->registrationTime)
+                << ", Status: " << current->getStatusName()
                 << ", Priority: " << current->priority
                 << ", Group: " << current->groupID
                 << ", W/L: " << current->wins << "/" << current->losses << std::endl;
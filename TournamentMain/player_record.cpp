@@ -0,0 +1,285 @@
+#include "player_record.hpp"
+#include "text_fields.hpp"
+#include <cstring>  // For memcpy and memcmp
+#include <ctime>    // For mktime and localtime
+#include <ostream>
+#include <iostream> // For std::cerr
+
+// --- NamePool ---
+
+// FNV-1a over the name bytes
+static std::uint32_t hashName(const char* text, size_t length) {
+    std::uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<unsigned char>(text[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+NamePool::NamePool() : blockCursor(nullptr), blockLeft(0) {
+    table.assign(1024, 0);
+    intern("", 0); // Handle 0
+}
+
+NamePool::~NamePool() {
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        delete[] blocks[i];
+    }
+}
+
+// Copies the text (plus terminator) into block storage
+char* NamePool::store(const char* text, size_t length) {
+    size_t needed = length + 1;
+    char* destination;
+    if (needed > BLOCK_SIZE / 4) {
+        destination = new char[needed]; // Oversized name: its own allocation
+        blocks.push_back(destination);
+    }
+    else {
+        if (needed > blockLeft) {
+            blockCursor = new char[BLOCK_SIZE];
+            blockLeft = BLOCK_SIZE;
+            blocks.push_back(blockCursor);
+        }
+        destination = blockCursor;
+        blockCursor += needed;
+        blockLeft -= needed;
+    }
+    memcpy(destination, text, length);
+    destination[length] = '\0';
+    return destination;
+}
+
+void NamePool::growTable() {
+    table.assign(table.size() * 2, 0);
+    size_t mask = table.size() - 1;
+    for (size_t id = 0; id < strings.size(); ++id) {
+        size_t i = hashes[id] & mask;
+        while (table[i] != 0) i = (i + 1) & mask;
+        table[i] = static_cast<std::uint32_t>(id + 1);
+    }
+}
+
+NameId NamePool::intern(const char* text, size_t length) {
+    std::uint32_t hash = hashName(text, length);
+    size_t mask = table.size() - 1;
+    size_t i = hash & mask;
+    while (table[i] != 0) {
+        NameId id = table[i] - 1;
+        if (hashes[id] == hash && lengths[id] == length && memcmp(strings[id], text, length) == 0) {
+            return id;
+        }
+        i = (i + 1) & mask;
+    }
+
+    NameId id = static_cast<NameId>(strings.size());
+    strings.push_back(store(text, length));
+    hashes.push_back(hash);
+    lengths.push_back(length);
+    table[i] = id + 1;
+    if (strings.size() * 2 > table.size()) {
+        growTable();
+    }
+    return id;
+}
+
+NamePool& playerNames() {
+    static NamePool pool;
+    return pool;
+}
+
+// --- Status and registration type codes ---
+
+// A one-byte code per distinct string, seeded with the built-in values in enum order
+class CodeTable {
+public:
+    CodeTable(const char* const* builtins, int count) {
+        names.reserve(256); // Never reallocates, so text() pointers stay valid
+        for (int i = 0; i < count; ++i) {
+            names.push_back(builtins[i]);
+        }
+    }
+
+    std::uint8_t intern(const char* begin, const char* end, const char* what) {
+        while (begin < end && (*begin == ' ' || *begin == '\t')) ++begin;
+        while (end > begin && (end[-1] == ' ' || end[-1] == '\t')) --end;
+        size_t length = static_cast<size_t>(end - begin);
+        for (size_t code = 0; code < names.size(); ++code) {
+            if (names[code].size() == length && memcmp(names[code].data(), begin, length) == 0) {
+                return static_cast<std::uint8_t>(code);
+            }
+        }
+        if (names.size() == 256) {
+            std::cerr << "Warning: Too many distinct " << what << " values, '" << std::string(begin, end) << "' stored as empty." << std::endl;
+            return 0;
+        }
+        names.push_back(std::string(begin, end));
+        return static_cast<std::uint8_t>(names.size() - 1);
+    }
+
+    const char* text(std::uint8_t code) const {
+        return code < names.size() ? names[code].c_str() : "";
+    }
+
+private:
+    std::vector<std::string> names; // Text per code
+};
+
+static CodeTable& statusCodes() {
+    static const char* const builtins[STATUS_BUILTIN_COUNT] = {
+        "", "Registered", "CheckedIn", "Withdrawn", "Playing", "Advanced", "Finalist", "Eliminated", "Winner"
+    };
+    static CodeTable table(builtins, STATUS_BUILTIN_COUNT);
+    return table;
+}
+
+static CodeTable& regTypeCodes() {
+    static const char* const builtins[REG_BUILTIN_COUNT] = { "", "wildcard", "earlybird", "normal" };
+    static CodeTable table(builtins, REG_BUILTIN_COUNT);
+    return table;
+}
+
+PlayerStatus internStatus(const char* begin, const char* end) {
+    return static_cast<PlayerStatus>(statusCodes().intern(begin, end, "status"));
+}
+
+RegistrationType internRegType(const char* begin, const char* end) {
+    return static_cast<RegistrationType>(regTypeCodes().intern(begin, end, "registration type"));
+}
+
+const char* statusName(PlayerStatus status) {
+    return statusCodes().text(status);
+}
+
+const char* regTypeName(RegistrationType type) {
+    return regTypeCodes().text(type);
+}
+
+// --- Registration times ---
+
+// Reads exactly 'digits' decimal digits at 'cursor'
+static bool readNumber(const char*& cursor, const char* end, int digits, int& value) {
+    value = 0;
+    for (int i = 0; i < digits; ++i) {
+        if (cursor == end || *cursor < '0' || *cursor > '9') return false;
+        value = value * 10 + (*cursor++ - '0');
+    }
+    return true;
+}
+
+static bool expectChar(const char*& cursor, const char* end, char expected) {
+    if (cursor == end || *cursor != expected) return false;
+    ++cursor;
+    return true;
+}
+
+std::int64_t parseRegistrationTime(const char* begin, const char* end) {
+    while (begin < end && (*begin == ' ' || *begin == '\t')) ++begin;
+    while (end > begin && (end[-1] == ' ' || end[-1] == '\t')) --end;
+
+    int year, month, day, hour, minute, second;
+    const char* cursor = begin;
+    if (!readNumber(cursor, end, 4, year) || !expectChar(cursor, end, '-') ||
+        !readNumber(cursor, end, 2, month) || !expectChar(cursor, end, '-') ||
+        !readNumber(cursor, end, 2, day) || !expectChar(cursor, end, ' ') ||
+        !readNumber(cursor, end, 2, hour) || !expectChar(cursor, end, ':') ||
+        !readNumber(cursor, end, 2, minute) || !expectChar(cursor, end, ':') ||
+        !readNumber(cursor, end, 2, second)) {
+        return 0;
+    }
+    if (cursor != end) {
+        // 12-hour clock as written by the registration module
+        if (end - cursor != 3 || cursor[0] != ' ' || (cursor[2] != 'M' && cursor[2] != 'm') || hour < 1 || hour > 12) return 0;
+        char half = cursor[1];
+        if (half == 'A' || half == 'a') hour = hour == 12 ? 0 : hour;
+        else if (half == 'P' || half == 'p') hour = hour == 12 ? 12 : hour + 12;
+        else return 0;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60) return 0;
+
+    // mktime is slow, and a file's registration times cluster in a few hours, so the
+    // start of the last hour seen is cached (time zone offsets change on hour boundaries)
+    thread_local int cachedKey = -1;
+    thread_local std::int64_t cachedHourStart = 0;
+    int key = ((year * 12 + month) * 31 + day) * 24 + hour;
+    if (key != cachedKey) {
+        std::tm local{};
+        local.tm_year = year - 1900;
+        local.tm_mon = month - 1;
+        local.tm_mday = day;
+        local.tm_hour = hour;
+        local.tm_isdst = -1; // Let the C library decide whether DST applies
+        std::time_t hourStart = std::mktime(&local);
+        if (hourStart == static_cast<std::time_t>(-1)) return 0;
+        cachedKey = key;
+        cachedHourStart = static_cast<std::int64_t>(hourStart);
+    }
+    return cachedHourStart + minute * 60 + second;
+}
+
+std::string formatRegistrationTime(std::int64_t seconds) {
+    if (seconds == 0) return "";
+    std::time_t value = static_cast<std::time_t>(seconds);
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &value);
+#else
+    localtime_r(&value, &local);
+#endif
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %I:%M:%S %p", &local);
+    return buffer;
+}
+
+std::int64_t currentRegistrationTime() {
+    return static_cast<std::int64_t>(std::time(nullptr));
+}
+
+// --- players.txt lines ---
+
+bool parsePlayerLine(const char* begin, const char* end, Player& out) {
+    FieldRange fields[6];
+    int fieldCount = splitFields(begin, end, fields, 6);
+    if (fieldCount != 5 && fieldCount != 6) return false;
+
+    int id, priority;
+    if (!parseIntField(fields[0], id) || !parseIntField(fields[fieldCount - 1], priority)) {
+        return false;
+    }
+
+    const char* nameBegin = fields[1].begin;
+    const char* nameEnd = fields[1].end;
+    while (nameBegin < nameEnd && (*nameBegin == ' ' || *nameBegin == '\t')) ++nameBegin;
+    while (nameEnd > nameBegin && (nameEnd[-1] == ' ' || nameEnd[-1] == '\t')) --nameEnd;
+
+    out = Player();
+    out.playerID = id;
+    out.priority = priority;
+    out.name = playerNames().intern(nameBegin, static_cast<size_t>(nameEnd - nameBegin));
+    out.registrationTime = parseRegistrationTime(fields[2].begin, fields[2].end);
+    out.status = internStatus(fields[3].begin, fields[3].end);
+    out.regType = fieldCount == 6 ? internRegType(fields[4].begin, fields[4].end) : REG_NONE;
+    return true;
+}
+
+void appendPlayerLine(std::string& out, const Player& player) {
+    out += std::to_string(player.playerID);
+    out += ',';
+    out += player.getName();
+    out += ',';
+    out += formatRegistrationTime(player.registrationTime);
+    out += ',';
+    out += player.getStatusName();
+    out += ',';
+    out += player.getRegTypeName();
+    out += ',';
+    out += std::to_string(player.priority);
+    out += '\n';
+}
+
+std::ostream& writePlayerLine(std::ostream& out, const Player& player) {
+    std::string line;
+    appendPlayerLine(line, player);
+    return out << line;
+}
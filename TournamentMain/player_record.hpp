@@ -0,0 +1,145 @@
+#ifndef PLAYER_RECORD_HPP
+#define PLAYER_RECORD_HPP
+
+#include <cstdint>
+#include <cstddef> // For size_t
+#include <string>
+#include <vector>
+#include <iosfwd>  // For std::ostream
+
+// The player record shared by match scheduling (Task 1) and registration (Task 2).
+// Text fields are not stored inline: names are handles into one shared NamePool,
+// status and registration type are one-byte codes, and the registration time is
+// seconds since the epoch. A record is 48 bytes, where the old scheduling node
+// carried 90 bytes of fixed char arrays and the registration record four std::strings.
+
+// Handle of an interned name (0 is the empty name)
+typedef std::uint32_t NameId;
+
+// Deduplicating store for player names. Every distinct name is kept once, in large
+// blocks that never move, so the text of a handle stays valid for the whole run.
+// Not synchronized: intern from one thread at a time (lookups may run concurrently).
+class NamePool {
+public:
+    NamePool();
+    ~NamePool();
+
+    // Returns the handle of the given text, adding it on first use
+    NameId intern(const char* text, size_t length);
+    NameId intern(const std::string& text) { return intern(text.data(), text.size()); }
+
+    // Null-terminated text of a handle
+    const char* text(NameId id) const { return strings[id]; }
+
+    // Number of distinct names stored (including the empty name)
+    size_t size() const { return strings.size(); }
+
+private:
+    static const size_t BLOCK_SIZE = 64 * 1024;
+
+    std::vector<const char*> strings;   // Text per handle
+    std::vector<std::uint32_t> hashes;  // Hash per handle, reused when the table grows
+    std::vector<size_t> lengths;        // Text length per handle, checked before comparing bytes
+    std::vector<std::uint32_t> table;   // Open addressing: handle + 1, 0 marks an empty bucket
+    std::vector<char*> blocks;          // Owned text storage
+    char* blockCursor;                  // Free space in the newest block
+    size_t blockLeft;
+
+    char* store(const char* text, size_t length);
+    void growTable();
+
+    NamePool(const NamePool&);
+    NamePool& operator=(const NamePool&);
+};
+
+// The pool every player name is interned in
+NamePool& playerNames();
+
+// Player status. Codes past STATUS_BUILTIN_COUNT are interned on the fly for status
+// strings found in files that are not one of the built-in ones.
+enum PlayerStatus : std::uint8_t {
+    STATUS_NONE,        // Empty status
+    STATUS_REGISTERED,
+    STATUS_CHECKED_IN,
+    STATUS_WITHDRAWN,
+    STATUS_PLAYING,
+    STATUS_ADVANCED,
+    STATUS_FINALIST,
+    STATUS_ELIMINATED,
+    STATUS_WINNER,
+    STATUS_BUILTIN_COUNT
+};
+
+// Registration type, interned the same way as the status
+enum RegistrationType : std::uint8_t {
+    REG_NONE,           // No type recorded (scheduling-only player files)
+    REG_WILDCARD,
+    REG_EARLYBIRD,
+    REG_NORMAL,
+    REG_BUILTIN_COUNT
+};
+
+// Code of a status/type string (trimmed of spaces); unknown strings get new codes
+PlayerStatus internStatus(const char* begin, const char* end);
+inline PlayerStatus internStatus(const std::string& text) { return internStatus(text.data(), text.data() + text.size()); }
+RegistrationType internRegType(const char* begin, const char* end);
+inline RegistrationType internRegType(const std::string& text) { return internRegType(text.data(), text.data() + text.size()); }
+
+// Text of a status/type code, as written to the files
+const char* statusName(PlayerStatus status);
+const char* regTypeName(RegistrationType type);
+
+// Parses "YYYY-MM-DD HH:MM:SS" with an optional " AM"/" PM" suffix as local time.
+// Returns 0 for blank or malformed text (0 means "no registration time").
+std::int64_t parseRegistrationTime(const char* begin, const char* end);
+inline std::int64_t parseRegistrationTime(const std::string& text) { return parseRegistrationTime(text.data(), text.data() + text.size()); }
+
+// Formats as "YYYY-MM-DD hh:MM:SS AM" in local time (the registration file format),
+// or an empty string for 0
+std::string formatRegistrationTime(std::int64_t seconds);
+
+// Seconds since the epoch right now
+std::int64_t currentRegistrationTime();
+
+// Define the Player structure (node for the scheduling linked list, element of the
+// registration queue)
+struct Player {
+    int playerID;
+    NameId name;                   // Handle into playerNames()
+    std::int64_t registrationTime; // Seconds since the epoch, 0 if unknown
+    int priority;                  // For initial seeding/ranking (1 = wildcard ... 3 = normal)
+    int groupID;                   // To assign players to specific groups for group stage
+    int wins;                      // Tracks wins in group stage (or overall)
+    int losses;                    // Tracks losses in group stage (or overall)
+    int standingsSlot;             // Row in the scheduler's StandingsStore, -1 if not tracked there
+    PlayerStatus status;           // e.g. Registered, CheckedIn, Playing, Eliminated, Advanced, Winner
+    RegistrationType regType;      // wildcard, earlybird or normal
+    bool statusChanged;            // Listed in PlayerList::statusChanges, waiting to be written out
+    Player* next;                  // Pointer to the next player in the list
+
+    Player()
+        : playerID(0), name(0), registrationTime(0), priority(0), groupID(0), wins(0), losses(0),
+          standingsSlot(-1), status(STATUS_NONE), regType(REG_NONE), statusChanged(false), next(nullptr) {}
+
+    Player(int id, const std::string& playerName, std::int64_t regTime, PlayerStatus s, int p, RegistrationType type = REG_NONE, int g = 0)
+        : playerID(id), name(playerNames().intern(playerName)), registrationTime(regTime), priority(p), groupID(g),
+          wins(0), losses(0), standingsSlot(-1), status(s), regType(type), statusChanged(false), next(nullptr) {}
+
+    const char* getName() const { return playerNames().text(name); }
+    const char* getStatusName() const { return statusName(status); }
+    const char* getRegTypeName() const { return regTypeName(regType); }
+};
+
+// Parses one players.txt line: PlayerID, Name, RegistrationTime, Status, Priority.
+// Lines written by the registration module carry RegType before Priority.
+// Fields are trimmed; returns false if the line does not have 5 or 6 fields or the
+// ID or priority is not a number.
+bool parsePlayerLine(const char* begin, const char* end, Player& out);
+
+// Appends "id,name,registrationTime,status,regType,priority\n" (the registration format)
+void appendPlayerLine(std::string& out, const Player& player);
+
+// Writes one player line to a stream
+std::ostream& writePlayerLine(std::ostream& out, const Player& player);
+
+#endif // PLAYER_RECORD_HPP
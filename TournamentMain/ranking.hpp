@@ -0,0 +1,59 @@
+#ifndef RANKING_HPP
+#define RANKING_HPP
+
+#include <vector>    // Handle arrays that get sorted instead of the player nodes
+#include <algorithm> // For std::sort and std::partial_sort
+#include <cstdint>   // For fixed-width packed keys
+
+struct Player; // Handles only point at players, so the full definition is not needed here
+
+// A sortable handle for one player: the packed ranking key plus the node it describes.
+// Sorting handles never moves the player payloads themselves.
+struct RankEntry {
+    std::uint64_t key; // Packed (wins, -losses, priority), larger ranks higher
+    int order;         // Position in the source list, breaks exact ties so results are stable
+    Player* player;    // The player this entry ranks
+};
+
+// Packs (wins, -losses, priority) into a single key where a larger key means a better rank.
+// Each field gets 21 bits; values are clamped so one field can never spill into another.
+inline std::uint64_t makeRankingKey(int wins, int losses, int priority) {
+    const std::int64_t fieldMax = (1 << 21) - 1;
+    const std::int64_t priorityBias = 1 << 20; // Lets negative priorities sort below zero
+
+    std::int64_t w = std::min<std::int64_t>(std::max(wins, 0), fieldMax);
+    std::int64_t l = std::min<std::int64_t>(std::max(losses, 0), fieldMax);
+    std::int64_t p = std::min<std::int64_t>(std::max<std::int64_t>(static_cast<std::int64_t>(priority) + priorityBias, 0), fieldMax);
+
+    return (static_cast<std::uint64_t>(w) << 42) |
+        (static_cast<std::uint64_t>(fieldMax - l) << 21) |
+        static_cast<std::uint64_t>(p);
+}
+
+// Strict ordering used by every ranking pass: higher key first, then original list order
+inline bool ranksBefore(const RankEntry& a, const RankEntry& b) {
+    if (a.key != b.key) return a.key > b.key;
+    return a.order < b.order;
+}
+
+// Sorts every handle into ranking order in O(n log n)
+inline void sortRankEntries(std::vector<RankEntry>& entries) {
+    std::sort(entries.begin(), entries.end(), ranksBefore);
+}
+
+// Keeps only the best k handles, in ranking order, without sorting the rest of the field.
+// Runs in O(n log k), which is what knockout qualification needs for a small k.
+inline void selectTopRankEntries(std::vector<RankEntry>& entries, int k) {
+    if (k <= 0) {
+        entries.clear();
+        return;
+    }
+    if (static_cast<size_t>(k) >= entries.size()) {
+        sortRankEntries(entries);
+        return;
+    }
+    std::partial_sort(entries.begin(), entries.begin() + k, entries.end(), ranksBefore);
+    entries.resize(static_cast<size_t>(k));
+}
+
+#endif // RANKING_HPP
@@ -0,0 +1,215 @@
+#include "registration_import.hpp"
+#include "tournament_registration.hpp"
+#include "registration_journal.hpp"
+#include "id_registry.hpp"
+#include "mapped_file.hpp"
+#include "text_fields.hpp"
+#include "output_writer.hpp" // For writeFileAtomically
+#include "perf_stats.hpp"
+#include <algorithm>
+#include <cstring> // For memchr
+#include <functional> // For std::ref
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Chunks smaller than this are not worth a thread of their own
+static const size_t MIN_CHUNK_BYTES = 16 * 1024;
+
+// One data row of the CSV after the parallel pass
+struct ImportRow {
+    int line;                 // Line number within its chunk (1-based)
+    int id;
+    const char* begin;        // The raw line, for the report
+    const char* end;
+    std::string name;         // Validated name and type (unset for rejected rows)
+    std::string regType;
+    const char* error;        // Why the row was rejected, or nullptr
+};
+
+struct ImportChunk {
+    const char* begin;
+    const char* end;
+    int lineCount;            // Lines in the chunk, to number the next chunk's lines
+    std::vector<ImportRow> rows;
+};
+
+static std::string trimField(const FieldRange& field) {
+    return trim(std::string(field.begin, field.end));
+}
+
+// Parses and validates one CSV line. Only reads shared state (the ID registry), so
+// chunks can be checked concurrently.
+static void parseImportRow(const char* begin, const char* end, ImportRow& row) {
+    row.begin = begin;
+    row.end = end;
+    row.id = 0;
+    row.error = nullptr;
+
+    FieldRange fields[4];
+    int count = splitFields(begin, end, fields, 4);
+    if (count != 3 && count != 4) {
+        row.error = "expected id,name,regType or id,firstName,lastName,regType";
+        return;
+    }
+    if (!parseIntField(fields[0], row.id) || row.id <= 0) {
+        row.error = "ID must be a positive number";
+        return;
+    }
+    if (count == 3) {
+        row.name = trimField(fields[1]);
+        if (!isAlphaString(row.name)) {
+            row.error = "name must contain letters only";
+            return;
+        }
+    }
+    else {
+        std::string firstName = trimField(fields[1]);
+        std::string lastName = trimField(fields[2]);
+        if (!isAlphaString(firstName) || !isAlphaString(lastName)) {
+            row.error = "first and last name must contain letters only";
+            return;
+        }
+        row.name = firstName + " " + lastName;
+    }
+    row.regType = trimField(fields[count - 1]);
+    if (!isValidRegType(row.regType)) {
+        row.error = "registration type must be 'wildcard', 'earlybird', or 'normal'";
+        return;
+    }
+    if (idRegistry().has(row.id, IdRegistry::QUEUED | IdRegistry::CHECKED_IN | IdRegistry::WITHDRAWN)) {
+        row.error = "ID already used";
+    }
+}
+
+// Parses every line of a chunk; the file's first line is skipped if it is a header
+static void parseImportChunk(ImportChunk& chunk, bool firstChunk) {
+    chunk.lineCount = 0;
+    const char* cursor = chunk.begin;
+    while (cursor < chunk.end) {
+        const char* lineEnd = static_cast<const char*>(memchr(cursor, '\n', static_cast<size_t>(chunk.end - cursor)));
+        const char* next = lineEnd ? lineEnd + 1 : chunk.end;
+        const char* contentEnd = lineEnd ? lineEnd : chunk.end;
+        if (contentEnd > cursor && contentEnd[-1] == '\r') --contentEnd;
+        chunk.lineCount++;
+
+        const char* firstChar = cursor;
+        while (firstChar < contentEnd && (*firstChar == ' ' || *firstChar == '\t')) ++firstChar;
+        bool blank = firstChar == contentEnd;
+        bool header = false;
+        if (!blank && firstChunk && chunk.lineCount == 1) {
+            // A header line has no ID in front
+            const char* comma = static_cast<const char*>(memchr(cursor, ',', static_cast<size_t>(contentEnd - cursor)));
+            FieldRange idField = { cursor, comma ? comma : contentEnd };
+            int id;
+            header = !parseIntField(idField, id);
+        }
+        if (!blank && !header) {
+            ImportRow row;
+            row.line = chunk.lineCount;
+            parseImportRow(cursor, contentEnd, row);
+            chunk.rows.push_back(row);
+        }
+        cursor = next;
+    }
+}
+
+bool importRegistrations(PriorityQueue& pq, const char* csvFilename, const char* reportFilename,
+    ImportSummary& summary, int threadCount) {
+    PERF_SCOPE("registration.importRegistrations");
+    summary.rows = summary.imported = summary.rejected = 0;
+
+    MappedFile csv;
+    if (!csv.open(csvFilename)) {
+        std::cout << "Error: Could not open " << csvFilename << " file.\n";
+        return false;
+    }
+    const char* text = csv.data();
+    size_t size = csv.size();
+
+    // Split at line starts into one chunk per worker
+    if (threadCount < 1) {
+        threadCount = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+    }
+    threadCount = static_cast<int>(std::min<size_t>(static_cast<size_t>(threadCount), std::max<size_t>(size / MIN_CHUNK_BYTES, 1)));
+    std::vector<ImportChunk> chunks(static_cast<size_t>(threadCount));
+    const char* chunkStart = text;
+    for (int t = 0; t < threadCount; ++t) {
+        const char* chunkEnd = text + size;
+        if (t + 1 < threadCount) {
+            chunkEnd = std::max(text + size / threadCount * (t + 1), chunkStart);
+            const char* newline = static_cast<const char*>(memchr(chunkEnd, '\n', static_cast<size_t>(text + size - chunkEnd)));
+            chunkEnd = newline ? newline + 1 : text + size;
+        }
+        chunks[t].begin = chunkStart;
+        chunks[t].end = chunkEnd;
+        chunkStart = chunkEnd;
+    }
+
+    // Parse and validate the chunks in parallel; each worker fills only its own chunk
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threadCount; ++t) {
+        workers.emplace_back(parseImportChunk, std::ref(chunks[t]), false);
+    }
+    parseImportChunk(chunks[0], true); // The calling thread takes the first chunk
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+
+    // Merge on this thread: intern names, reject IDs repeated within the file
+    std::vector<Player> accepted;
+    std::string report;
+    IdIndex seen;
+    std::int64_t now = currentRegistrationTime();
+    int lineOffset = 0;
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        const std::vector<ImportRow>& rows = chunks[c].rows;
+        summary.rows += static_cast<int>(rows.size());
+        for (size_t r = 0; r < rows.size(); ++r) {
+            const ImportRow& row = rows[r];
+            const char* error = row.error;
+            if (error == nullptr && seen.contains(row.id)) {
+                error = "ID repeated in the file";
+            }
+            if (error != nullptr) {
+                report += "line " + std::to_string(lineOffset + row.line) + ": " + error + ": ";
+                report.append(row.begin, row.end);
+                report += '\n';
+                summary.rejected++;
+                continue;
+            }
+            seen.insert(row.id, 1);
+            RegistrationType type = internRegType(row.regType);
+            accepted.push_back(Player(row.id, row.name, now, STATUS_REGISTERED, priorityForRegType(type), type));
+        }
+        lineOffset += chunks[c].lineCount;
+    }
+    csv.close();
+
+    pq.insertBulk(accepted);
+    for (size_t i = 0; i < accepted.size(); ++i) {
+        idRegistry().update(accepted[i].playerID, IdRegistry::QUEUED);
+    }
+    summary.imported = static_cast<int>(accepted.size());
+    PERF_COUNT("registration.playersImported", summary.imported);
+
+    bool saved = registrationJournal().recordRegistrations(accepted, pq);
+    if (!saved) {
+        std::cout << "Error writing to the registration journal!\n";
+    }
+
+    std::string header = "# Import of " + std::string(csvFilename) + ": " + std::to_string(summary.rows) + " rows, " +
+        std::to_string(summary.imported) + " imported, " + std::to_string(summary.rejected) + " rejected\n";
+    if (!writeFileAtomically(reportFilename, header + report)) {
+        std::cout << "Error writing " << reportFilename << "!\n";
+        saved = false;
+    }
+
+    std::cout << "Imported " << summary.imported << " of " << summary.rows << " players from " << csvFilename << ".";
+    if (summary.rejected > 0) {
+        std::cout << " " << summary.rejected << " rejected rows are listed in " << reportFilename << ".";
+    }
+    std::cout << "\n";
+    return saved;
+}
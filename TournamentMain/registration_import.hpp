@@ -0,0 +1,25 @@
+#ifndef REGISTRATION_IMPORT_HPP
+#define REGISTRATION_IMPORT_HPP
+
+class PriorityQueue;
+
+// Outcome of a bulk registration import
+struct ImportSummary {
+    int rows;     // Data rows read (blank lines and the header are not counted)
+    int imported; // Rows registered
+    int rejected; // Rows written to the report
+};
+
+// Registers every valid row of a registration CSV at once. Rows are
+//   id,name,regType    or    id,firstName,lastName,regType
+// with an optional header line. The file is split into chunks that are parsed and
+// validated in parallel (numeric ID not already used, letters-only name, known
+// registration type). The valid rows are then merged on the calling thread: names are
+// interned, IDs repeated within the file are rejected, the queue takes them all with one
+// heapify and the registration journal with one append. Rejected rows go to
+// 'reportFilename' with their line number and reason.
+// Returns false if the CSV cannot be read or the journal or report cannot be written.
+bool importRegistrations(PriorityQueue& pq, const char* csvFilename, const char* reportFilename,
+    ImportSummary& summary, int threadCount = 0);
+
+#endif // REGISTRATION_IMPORT_HPP
@@ -0,0 +1,411 @@
+#include "registration_journal.hpp"
+#include "tournament_registration.hpp"
+#include "output_writer.hpp" // For writeFileAtomically
+#include "text_fields.hpp"
+#include "perf_stats.hpp"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <vector>
+#include <cstdio>  // For std::remove
+#include <cstring> // For memchr
+
+// One queued player as captured for a background snapshot. The text pointers refer to
+// interned storage that never moves, so the writer thread can format rows without
+// touching the pools that the main thread keeps adding to.
+struct SnapshotRow {
+    int playerID;
+    std::int64_t registrationTime;
+    int priority;
+    const char* name;
+    const char* status;
+    const char* regType;
+};
+
+// Reads a whole file; returns false if it cannot be opened
+static bool readWholeFile(const std::string& filename, std::string& contents) {
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    if (!file.is_open()) return false;
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    contents = buffer.str();
+    return true;
+}
+
+// Calls visit(begin, end) for every non-empty line of 'text' ('\r' stripped). In an
+// append-only file a final line without its newline is a torn append: it is skipped
+// with a warning when 'appendOnly' is set.
+template <typename Visitor>
+static void forEachLine(const std::string& text, const std::string& filename, bool appendOnly, Visitor visit) {
+    const char* cursor = text.data();
+    const char* end = cursor + text.size();
+    while (cursor < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+        if (lineEnd == nullptr) {
+            if (appendOnly) {
+                std::cerr << "Warning: Ignoring incomplete last line of " << filename << std::endl;
+                return;
+            }
+            lineEnd = end;
+        }
+        const char* contentEnd = lineEnd;
+        if (contentEnd > cursor && contentEnd[-1] == '\r') --contentEnd;
+        if (contentEnd > cursor) {
+            visit(cursor, contentEnd);
+        }
+        cursor = lineEnd + 1;
+    }
+}
+
+// Reads the "#seq N" header of a snapshot line; returns false if the line is not one
+static bool parseSnapshotHeader(const char* begin, const char* end, std::uint64_t& seq) {
+    const char prefix[] = "#seq ";
+    size_t prefixLength = sizeof(prefix) - 1;
+    if (static_cast<size_t>(end - begin) <= prefixLength || memcmp(begin, prefix, prefixLength) != 0) return false;
+    unsigned long long value = 0;
+    std::from_chars_result result = std::from_chars(begin + prefixLength, end, value);
+    if (result.ec != std::errc() || result.ptr != end) return false;
+    seq = value;
+    return true;
+}
+
+// Parses a snapshot line that holds a queued player: registration lines need a name and
+// a type, and only registered players are queued. Every other line is retained as is.
+static bool parseQueuedSnapshotLine(const char* begin, const char* end, Player& player) {
+    return parsePlayerLine(begin, end, player) && player.name != 0 && player.regType != REG_NONE &&
+        player.status == STATUS_REGISTERED;
+}
+
+// Splits a journal line into its sequence number, event name and the rest
+static bool parseJournalLine(const char* begin, const char* end, std::uint64_t& seq, std::string& event, const char*& rest) {
+    const char* comma = static_cast<const char*>(memchr(begin, ',', static_cast<size_t>(end - begin)));
+    if (comma == nullptr) return false;
+    unsigned long long value = 0;
+    std::from_chars_result result = std::from_chars(begin, comma, value);
+    if (result.ec != std::errc() || result.ptr != comma) return false;
+    const char* eventBegin = comma + 1;
+    const char* eventEnd = static_cast<const char*>(memchr(eventBegin, ',', static_cast<size_t>(end - eventBegin)));
+    if (eventEnd == nullptr) return false;
+    seq = value;
+    event.assign(eventBegin, eventEnd);
+    rest = eventEnd + 1;
+    return true;
+}
+
+RegistrationJournal::RegistrationJournal(const char* snapshotFilename, const char* journalFilename)
+    : snapshotFile(snapshotFilename), journalFile(journalFilename), initialized(false),
+      snapshotSeq(0), lastSeq(0), queuedPlayers(0), retainedLoaded(false),
+      compactionRunning(false), compactionSucceeded(false), compactionSeq(0) {
+    // The background writer reads interned text, so those pools must outlive this object
+    playerNames();
+    statusName(STATUS_NONE);
+    regTypeName(REG_NONE);
+}
+
+RegistrationJournal::~RegistrationJournal() {
+    waitForCompaction();
+}
+
+// Reads the sequence numbers from the files, without building a queue
+void RegistrationJournal::initialize() {
+    if (initialized) return;
+    snapshotSeq = 0;
+    std::ifstream snapshot(snapshotFile.c_str());
+    std::string header;
+    if (snapshot.is_open() && std::getline(snapshot, header)) {
+        if (!header.empty() && header[header.size() - 1] == '\r') header.erase(header.size() - 1);
+        parseSnapshotHeader(header.data(), header.data() + header.size(), snapshotSeq);
+    }
+
+    lastSeq = snapshotSeq;
+    std::string journal;
+    if (readWholeFile(journalFile, journal)) {
+        std::string event;
+        forEachLine(journal, journalFile, true, [&](const char* begin, const char* end) {
+            std::uint64_t seq;
+            const char* rest;
+            if (parseJournalLine(begin, end, seq, event, rest) && seq > lastSeq) lastSeq = seq;
+        });
+    }
+    initialized = true;
+}
+
+// Reads the snapshot lines that compaction has to carry over, without building a queue
+void RegistrationJournal::loadRetainedLines() {
+    retainedLines.clear();
+    std::string snapshot;
+    if (readWholeFile(snapshotFile, snapshot)) {
+        std::uint64_t seq;
+        forEachLine(snapshot, snapshotFile, false, [&](const char* begin, const char* end) {
+            Player player;
+            if ((*begin == '#' && parseSnapshotHeader(begin, end, seq)) || parseQueuedSnapshotLine(begin, end, player)) {
+                return;
+            }
+            retainedLines.append(begin, end);
+            retainedLines += '\n';
+        });
+    }
+    retainedLoaded = true;
+}
+
+void RegistrationJournal::load(PriorityQueue& pq) {
+    PERF_SCOPE("journal.load");
+    waitForCompaction();
+    pq.clear();
+
+    // Snapshot: the queued players as of sequence number snapshotSeq
+    snapshotSeq = 0;
+    std::string snapshot;
+    if (!readWholeFile(snapshotFile, snapshot)) {
+        std::cout << "Error: Could not open " << snapshotFile << " file.\n";
+    }
+    retainedLines.clear();
+    forEachLine(snapshot, snapshotFile, false, [&](const char* begin, const char* end) {
+        if (*begin == '#' && parseSnapshotHeader(begin, end, snapshotSeq)) {
+            return;
+        }
+        Player player;
+        if (!parseQueuedSnapshotLine(begin, end, player)) {
+            retainedLines.append(begin, end); // Not registration state: carried over as is
+            retainedLines += '\n';
+            return;
+        }
+        pq.insert(player);
+        PERF_COUNT("registration.playersQueued", 1);
+    });
+    retainedLoaded = true;
+
+    // Journal tail: every event the snapshot does not cover yet, in order
+    lastSeq = snapshotSeq;
+    std::string journal;
+    if (readWholeFile(journalFile, journal)) {
+        std::string event;
+        int replayed = 0;
+        forEachLine(journal, journalFile, true, [&](const char* begin, const char* end) {
+            std::uint64_t seq;
+            const char* rest;
+            if (!parseJournalLine(begin, end, seq, event, rest)) {
+                std::cerr << "Warning: Skipping malformed journal line: " << std::string(begin, end) << std::endl;
+                return;
+            }
+            if (seq <= snapshotSeq) return; // Already part of the snapshot
+            if (seq > lastSeq) lastSeq = seq;
+
+            if (event == "register" || event == "replace") {
+                Player player;
+                if (parsePlayerLine(rest, end, player)) {
+                    pq.insert(player);
+                    replayed++;
+                    return;
+                }
+            }
+            else if (event == "checkin" || event == "withdraw") {
+                FieldRange idField = { rest, end };
+                int id;
+                if (parseIntField(idField, id)) {
+                    pq.removeByID(id);
+                    replayed++;
+                    return;
+                }
+            }
+            std::cerr << "Warning: Skipping malformed journal line: " << std::string(begin, end) << std::endl;
+        });
+        PERF_COUNT("journal.eventsReplayed", replayed);
+    }
+    queuedPlayers = pq.getSize();
+    initialized = true;
+}
+
+bool RegistrationJournal::recordRegistration(const Player& player, const PriorityQueue& pq) {
+    std::string event = "register,";
+    appendPlayerLine(event, player);
+    event.erase(event.size() - 1); // appendPlayerLine ends the line
+    return append(event, pq);
+}
+
+bool RegistrationJournal::recordReplacement(const Player& player, const PriorityQueue& pq) {
+    std::string event = "replace,";
+    appendPlayerLine(event, player);
+    event.erase(event.size() - 1);
+    return append(event, pq);
+}
+
+bool RegistrationJournal::recordCheckIn(int playerID, const PriorityQueue& pq) {
+    return append("checkin," + std::to_string(playerID), pq);
+}
+
+bool RegistrationJournal::recordWithdrawal(int playerID, const PriorityQueue& pq) {
+    return append("withdraw," + std::to_string(playerID), pq);
+}
+
+// Appends one event line with the next sequence number in a single write
+bool RegistrationJournal::recordRegistrations(const std::vector<Player>& players, const PriorityQueue& pq) {
+    if (players.empty()) return true;
+    std::vector<std::string> events(players.size());
+    for (size_t i = 0; i < players.size(); ++i) {
+        events[i] = "register,";
+        appendPlayerLine(events[i], players[i]);
+        events[i].erase(events[i].size() - 1); // appendPlayerLine ends the line
+    }
+    return append(events.data(), events.size(), pq);
+}
+
+bool RegistrationJournal::append(const std::string& event, const PriorityQueue& pq) {
+    return append(&event, 1, pq);
+}
+
+bool RegistrationJournal::append(const std::string* events, size_t count, const PriorityQueue& pq) {
+    PERF_SCOPE("journal.append");
+    initialize();
+    if (compactionThread.joinable() && !compactionRunning) {
+        finishCompaction(); // A background snapshot completed since the last event
+    }
+
+    std::uint64_t seq = lastSeq;
+    std::string lines;
+    for (size_t i = 0; i < count; ++i) {
+        lines += std::to_string(++seq);
+        lines += ',';
+        lines += events[i];
+        lines += '\n';
+    }
+    {
+        std::ofstream file;
+        file.rdbuf()->pubsetbuf(nullptr, 0); // Unbuffered: the lines go out in one write call
+        file.open(journalFile.c_str(), std::ios::binary | std::ios::app);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+        if (!file) {
+            return false;
+        }
+    }
+    lastSeq = seq;
+    queuedPlayers = pq.getSize();
+    maybeCompact(pq);
+    return true;
+}
+
+void RegistrationJournal::maybeCompact(const PriorityQueue& pq) {
+    if (compactionRunning) return; // The next event checks again
+    std::uint64_t threshold = static_cast<std::uint64_t>(queuedPlayers / 2);
+    if (threshold < static_cast<std::uint64_t>(MIN_COMPACTION_EVENTS)) threshold = MIN_COMPACTION_EVENTS;
+    if (lastSeq - snapshotSeq >= threshold) {
+        startCompaction(pq);
+    }
+}
+
+// Captures the queue (the only O(n) work left on the caller's thread) and writes the
+// snapshot on a background thread
+void RegistrationJournal::startCompaction(const PriorityQueue& pq) {
+    PERF_SCOPE("journal.compactionCapture");
+    waitForCompaction();
+    if (!retainedLoaded) {
+        loadRetainedLines();
+    }
+
+    std::vector<const Player*> ordered;
+    pq.collectInOrder(ordered); // Serving order keeps the arrival order within each priority
+    std::vector<SnapshotRow> rows(ordered.size());
+    for (size_t i = 0; i < ordered.size(); ++i) {
+        const Player& player = *ordered[i];
+        SnapshotRow& row = rows[i];
+        row.playerID = player.playerID;
+        row.registrationTime = player.registrationTime;
+        row.priority = player.priority;
+        row.name = player.getName();
+        row.status = player.getStatusName();
+        row.regType = player.getRegTypeName();
+    }
+
+    compactionSeq = lastSeq;
+    compactionRunning = true;
+    compactionSucceeded = false;
+    std::string filename = snapshotFile;
+    std::uint64_t seq = compactionSeq;
+    std::string retained = retainedLines;
+    compactionThread = std::thread([this, filename, seq, retained](std::vector<SnapshotRow> snapshotRows) {
+        std::string contents = "#seq " + std::to_string(seq) + "\n" + retained;
+        for (size_t i = 0; i < snapshotRows.size(); ++i) {
+            const SnapshotRow& row = snapshotRows[i];
+            contents += std::to_string(row.playerID);
+            contents += ',';
+            contents += row.name;
+            contents += ',';
+            contents += formatRegistrationTime(row.registrationTime);
+            contents += ',';
+            contents += row.status;
+            contents += ',';
+            contents += row.regType;
+            contents += ',';
+            contents += std::to_string(row.priority);
+            contents += '\n';
+        }
+        compactionSucceeded = writeFileAtomically(filename.c_str(), contents);
+        compactionRunning = false;
+    }, std::move(rows));
+}
+
+// Joins a finished compaction and drops the journal lines its snapshot covers
+void RegistrationJournal::finishCompaction() {
+    compactionThread.join();
+    if (!compactionSucceeded) {
+        std::cerr << "Warning: Could not write the registration snapshot " << snapshotFile
+            << "; the journal keeps every event." << std::endl;
+        return;
+    }
+    snapshotSeq = compactionSeq;
+    trimJournal(compactionSeq);
+    PERF_COUNT("journal.compactions", 1);
+}
+
+void RegistrationJournal::waitForCompaction() {
+    if (compactionThread.joinable()) {
+        finishCompaction();
+    }
+}
+
+// Rewrites the journal without the events up to coveredSeq (only the short tail
+// appended while the snapshot was being written is left)
+void RegistrationJournal::trimJournal(std::uint64_t coveredSeq) {
+    std::string journal;
+    if (!readWholeFile(journalFile, journal)) return;
+
+    std::string kept;
+    std::string event;
+    forEachLine(journal, journalFile, true, [&](const char* begin, const char* end) {
+        std::uint64_t seq;
+        const char* rest;
+        if (parseJournalLine(begin, end, seq, event, rest) && seq <= coveredSeq) return;
+        kept.append(begin, end);
+        kept += '\n';
+    });
+    if (!writeFileAtomically(journalFile.c_str(), kept)) {
+        std::cerr << "Warning: Could not trim " << journalFile << "; covered events are skipped on load." << std::endl;
+    }
+}
+
+void RegistrationJournal::sync() {
+    PERF_SCOPE("journal.sync");
+    waitForCompaction();
+    initialize();
+    if (lastSeq == snapshotSeq) return; // The snapshot is already current
+
+    PriorityQueue current;
+    load(current);
+    startCompaction(current);
+    waitForCompaction();
+}
+
+void RegistrationJournal::discard() {
+    waitForCompaction();
+    std::remove(journalFile.c_str());
+    initialized = false;
+    retainedLoaded = false;
+}
+
+RegistrationJournal& registrationJournal() {
+    static RegistrationJournal journal("players.txt", "registration_journal.txt");
+    return journal;
+}
@@ -0,0 +1,95 @@
+#ifndef REGISTRATION_JOURNAL_HPP
+#define REGISTRATION_JOURNAL_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include "player_record.hpp"
+
+class PriorityQueue;
+
+// Registration state kept as a snapshot plus an append-only journal.
+//
+// The snapshot (players.txt) lists the queued players in the usual line format under a
+// "#seq N" header: it reflects every journal event up to sequence number N. Other lines
+// of the file (roster lines without a registration type, players who are no longer
+// queued, unparsable lines) are not registration state and are carried over unchanged
+// by every compaction. The journal
+// (registration_journal.txt) holds one line per event after that:
+//   seq,register,<player line>    seq,replace,<player line>
+//   seq,checkin,id                seq,withdraw,id
+// Loading reads the snapshot and replays the journal events past its sequence number.
+//
+// Recording an event is one small append. Once the journal tail outgrows
+// max(MIN_COMPACTION_EVENTS, queued players / 2), the queue is copied and a background
+// thread writes it out as the new snapshot (atomically, via a temp file); the journal
+// lines the snapshot covers are dropped afterwards. A crash at any point leaves either
+// the old snapshot with the full journal, or the new snapshot with a journal whose
+// covered events are skipped by sequence number.
+class RegistrationJournal {
+public:
+    static const int MIN_COMPACTION_EVENTS = 256;
+
+    RegistrationJournal(const char* snapshotFilename, const char* journalFilename);
+    ~RegistrationJournal(); // Waits for a running compaction
+
+    // Replaces the queue's contents with the snapshot plus the replayed journal tail
+    void load(PriorityQueue& pq);
+
+    // Journal events; each returns false if the journal could not be appended to.
+    // 'pq' is the queue after the event, used when the append triggers a compaction.
+    bool recordRegistration(const Player& player, const PriorityQueue& pq);
+    bool recordReplacement(const Player& player, const PriorityQueue& pq);
+    bool recordCheckIn(int playerID, const PriorityQueue& pq);
+    bool recordWithdrawal(int playerID, const PriorityQueue& pq);
+
+    // Registers a batch of players (a bulk import) with a single append
+    bool recordRegistrations(const std::vector<Player>& players, const PriorityQueue& pq);
+
+    // Folds the whole journal into the snapshot now and waits for it to be written,
+    // so readers of the snapshot file alone (match scheduling) see the current roster
+    void sync();
+
+    // Waits for a running background compaction and finishes it
+    void waitForCompaction();
+
+    // Forgets the journal (used when the snapshot file is replaced from outside)
+    void discard();
+
+    const char* getSnapshotFilename() const { return snapshotFile.c_str(); }
+    std::uint64_t getPendingEvents() const { return lastSeq - snapshotSeq; }
+
+private:
+    std::string snapshotFile;
+    std::string journalFile;
+    bool initialized;             // Sequence numbers have been read from the files
+    std::uint64_t snapshotSeq;    // Last event folded into the snapshot on disk
+    std::uint64_t lastSeq;        // Last event appended to the journal
+    int queuedPlayers;            // Queue size after the last event (drives the threshold)
+    std::string retainedLines;    // Snapshot lines that are not queued players, kept verbatim
+    bool retainedLoaded;          // retainedLines reflects the snapshot file
+
+    std::thread compactionThread;
+    std::atomic<bool> compactionRunning;
+    std::atomic<bool> compactionSucceeded;
+    std::uint64_t compactionSeq;  // Sequence number the running compaction covers
+
+    void initialize();
+    void loadRetainedLines();
+    bool append(const std::string& event, const PriorityQueue& pq);
+    bool append(const std::string* events, size_t count, const PriorityQueue& pq);
+    void maybeCompact(const PriorityQueue& pq);
+    void startCompaction(const PriorityQueue& pq);
+    void finishCompaction();
+    void trimJournal(std::uint64_t coveredSeq);
+
+    RegistrationJournal(const RegistrationJournal&);
+    RegistrationJournal& operator=(const RegistrationJournal&);
+};
+
+// The journal behind players.txt
+RegistrationJournal& registrationJournal();
+
+#endif // REGISTRATION_JOURNAL_HPP
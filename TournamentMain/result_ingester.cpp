@@ -0,0 +1,288 @@
+#include "result_ingester.hpp"
+#include "text_fields.hpp"
+#include "output_writer.hpp" // For writeFileAtomically
+#include <algorithm> // For std::remove_if
+#include <fstream>
+#include <iostream>
+#include <cstdio>  // For std::remove
+#include <cstring> // For memchr
+
+namespace {
+
+const size_t signatureLength = 32; // Bytes of consumed content remembered to detect rewrites
+
+std::string toHex(const std::string& bytes) {
+    static const char digits[] = "0123456789abcdef";
+    std::string hex;
+    hex.reserve(bytes.size() * 2);
+    for (unsigned char c : bytes) {
+        hex.push_back(digits[c >> 4]);
+        hex.push_back(digits[c & 0x0F]);
+    }
+    return hex;
+}
+
+std::string fromHex(const std::string& hex) {
+    std::string bytes;
+    for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+        int value = 0;
+        std::from_chars(hex.data() + i, hex.data() + i + 2, value, 16);
+        bytes.push_back(static_cast<char>(value));
+    }
+    return bytes;
+}
+
+} // namespace
+
+ResultIngester::ResultIngester() : consumedBytes(0) {}
+
+bool ResultIngester::readNewResults(const char* resultsFilename, std::vector<ResultEntry>& out) {
+    attach(resultsFilename);
+
+    // Results deferred by the previous read come first, in their original order
+    out.insert(out.end(), deferred.begin(), deferred.end());
+    deferred.clear();
+    nowDeferred.clear();
+
+    std::ifstream file(resultsFilename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file.seekg(0, std::ios::end);
+    std::int64_t fileSize = static_cast<std::int64_t>(file.tellg());
+
+    // The file was truncated or rewritten if it shrank or the bytes we consumed last changed
+    bool rewritten = fileSize < consumedBytes;
+    if (!rewritten && !tailSignature.empty()) {
+        std::string current(tailSignature.size(), '\0');
+        file.seekg(consumedBytes - static_cast<std::int64_t>(tailSignature.size()));
+        file.read(&current[0], static_cast<std::streamsize>(current.size()));
+        rewritten = !file || current != tailSignature;
+    }
+    if (rewritten) {
+        consumedBytes = 0;
+        tailSignature.clear();
+    }
+    if (fileSize == consumedBytes) {
+        return true; // Nothing appended since the last call
+    }
+
+    // Read only the bytes appended since the last call
+    std::string buffer(static_cast<size_t>(fileSize - consumedBytes), '\0');
+    file.clear();
+    file.seekg(consumedBytes);
+    file.read(&buffer[0], static_cast<std::streamsize>(buffer.size()));
+    buffer.resize(static_cast<size_t>(file.gcount()));
+
+    // A trailing line without a newline may still be being written; leave it for the next call
+    size_t completeLength = buffer.rfind('\n');
+    if (completeLength == std::string::npos) {
+        return true;
+    }
+    completeLength++;
+
+    const char* cursor = buffer.data();
+    const char* end = buffer.data() + completeLength;
+    while (cursor < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+        const char* contentEnd = lineEnd;
+        if (contentEnd > cursor && contentEnd[-1] == '\r') --contentEnd;
+
+        if (contentEnd > cursor) {
+            FieldRange fields[3];
+            ResultEntry entry;
+            if (splitFields(cursor, contentEnd, fields, 3) == 3 &&
+                parseIntField(fields[0], entry.matchID) &&
+                parseIntField(fields[1], entry.winnerID) &&
+                parseIntField(fields[2], entry.loserID)) {
+                if (!isProcessed(entry.matchID)) {
+                    out.push_back(entry); // Counts as processed once the caller confirms it
+                }
+            }
+            else {
+                std::cerr << "Warning: Failed to parse result line: " << std::string(cursor, contentEnd) << std::endl;
+            }
+        }
+        cursor = lineEnd + 1;
+    }
+
+    consumedBytes += static_cast<std::int64_t>(completeLength);
+    std::string recent = tailSignature + buffer.substr(0, completeLength);
+    tailSignature = recent.substr(recent.size() > signatureLength ? recent.size() - signatureLength : 0);
+    return true;
+}
+
+void ResultIngester::confirmResult(const ResultEntry& entry) {
+    if (!isProcessed(entry.matchID)) {
+        markProcessed(entry.matchID);
+        newlyProcessed.push_back(entry.matchID);
+    }
+}
+
+void ResultIngester::deferResult(const ResultEntry& entry) {
+    for (size_t i = 0; i < nowDeferred.size(); ++i) {
+        if (nowDeferred[i].matchID == entry.matchID) return; // Keep the first report of a match
+    }
+    nowDeferred.push_back(entry);
+}
+
+void ResultIngester::commit() {
+    deferred.swap(nowDeferred);
+    nowDeferred.clear();
+    saveCheckpoint();
+    newlyProcessed.clear();
+}
+
+void ResultIngester::forgetProcessed(const char* resultsFilename, int firstID, int lastID) {
+    attach(resultsFilename);
+
+    bool changed = false;
+    for (int matchID = firstID; matchID <= lastID; ++matchID) {
+        if (isProcessed(matchID)) {
+            clearProcessed(matchID);
+            changed = true;
+        }
+    }
+    std::vector<ResultEntry>::iterator kept = std::remove_if(deferred.begin(), deferred.end(),
+        [firstID, lastID](const ResultEntry& entry) { return entry.matchID >= firstID && entry.matchID <= lastID; });
+    if (kept != deferred.end()) {
+        deferred.erase(kept, deferred.end());
+        changed = true;
+    }
+    if (!changed) return;
+
+    // Rewrite the processed log without the forgotten IDs
+    std::string lines;
+    for (size_t word = 0; word < processedBits.size(); ++word) {
+        for (int bit = 0; bit < 64; ++bit) {
+            if ((processedBits[word] >> bit) & 1) {
+                lines += std::to_string(static_cast<int>(word * 64) + bit);
+                lines += '\n';
+            }
+        }
+    }
+    for (int matchID : processedOverflow) {
+        lines += std::to_string(matchID);
+        lines += '\n';
+    }
+    if (!writeFileAtomically(processedFilename().c_str(), lines)) {
+        std::cerr << "Warning: Could not rewrite processed results log: " << processedFilename() << std::endl;
+    }
+    newlyProcessed.clear(); // Already part of the rewritten log
+    saveCheckpoint();
+}
+
+void ResultIngester::reset(const char* resultsFilename) {
+    attachedFile = resultsFilename;
+    consumedBytes = 0;
+    tailSignature.clear();
+    processedBits.clear();
+    processedOverflow.clear();
+    deferred.clear();
+    nowDeferred.clear();
+    newlyProcessed.clear();
+    std::remove(checkpointFilename().c_str());
+    std::remove(processedFilename().c_str());
+}
+
+void ResultIngester::attach(const char* resultsFilename) {
+    if (attachedFile == resultsFilename) return;
+
+    attachedFile = resultsFilename;
+    consumedBytes = 0;
+    tailSignature.clear();
+    processedBits.clear();
+    processedOverflow.clear();
+    deferred.clear();
+    nowDeferred.clear();
+    newlyProcessed.clear();
+
+    std::ifstream checkpoint(checkpointFilename());
+    if (checkpoint.is_open()) {
+        std::string offsetLine, signatureLine, line;
+        std::getline(checkpoint, offsetLine);
+        std::getline(checkpoint, signatureLine);
+        long long offset = 0;
+        std::from_chars(offsetLine.data(), offsetLine.data() + offsetLine.size(), offset);
+        consumedBytes = offset;
+        tailSignature = fromHex(signatureLine);
+
+        // Remaining lines are the deferred results: MatchID,WinnerID,LoserID
+        while (std::getline(checkpoint, line)) {
+            FieldRange fields[3];
+            ResultEntry entry;
+            if (splitFields(line.data(), line.data() + line.size(), fields, 3) == 3 &&
+                parseIntField(fields[0], entry.matchID) &&
+                parseIntField(fields[1], entry.winnerID) &&
+                parseIntField(fields[2], entry.loserID)) {
+                deferred.push_back(entry);
+            }
+        }
+    }
+
+    std::ifstream processed(processedFilename());
+    std::string line;
+    while (std::getline(processed, line)) {
+        int matchID;
+        FieldRange field = { line.data(), line.data() + line.size() };
+        if (parseIntField(field, matchID)) {
+            markProcessed(matchID);
+        }
+    }
+}
+
+bool ResultIngester::isProcessed(int matchID) const {
+    if (matchID >= 0 && matchID < bitmapLimit) {
+        size_t word = static_cast<size_t>(matchID) >> 6;
+        return word < processedBits.size() && (processedBits[word] >> (matchID & 63)) & 1;
+    }
+    return processedOverflow.count(matchID) != 0;
+}
+
+void ResultIngester::markProcessed(int matchID) {
+    if (matchID >= 0 && matchID < bitmapLimit) {
+        size_t word = static_cast<size_t>(matchID) >> 6;
+        if (word >= processedBits.size()) {
+            processedBits.resize(word + 1, 0);
+        }
+        processedBits[word] |= std::uint64_t(1) << (matchID & 63);
+    }
+    else {
+        processedOverflow.insert(matchID);
+    }
+}
+
+void ResultIngester::clearProcessed(int matchID) {
+    if (matchID >= 0 && matchID < bitmapLimit) {
+        size_t word = static_cast<size_t>(matchID) >> 6;
+        if (word < processedBits.size()) {
+            processedBits[word] &= ~(std::uint64_t(1) << (matchID & 63));
+        }
+    }
+    else {
+        processedOverflow.erase(matchID);
+    }
+}
+
+void ResultIngester::saveCheckpoint() {
+    if (!newlyProcessed.empty()) {
+        std::ofstream processed(processedFilename(), std::ios::app);
+        std::string lines;
+        for (int matchID : newlyProcessed) {
+            lines += std::to_string(matchID);
+            lines += '\n';
+        }
+        processed << lines;
+    }
+
+    // Replaced atomically: a torn offset would re-apply or skip results after a crash
+    std::string contents = std::to_string(consumedBytes) + "\n" + toHex(tailSignature) + "\n";
+    for (size_t i = 0; i < deferred.size(); ++i) {
+        contents += std::to_string(deferred[i].matchID) + "," + std::to_string(deferred[i].winnerID) + "," +
+            std::to_string(deferred[i].loserID) + "\n";
+    }
+    if (!writeFileAtomically(checkpointFilename().c_str(), contents)) {
+        std::cerr << "Warning: Could not save results checkpoint: " << checkpointFilename() << std::endl;
+    }
+}
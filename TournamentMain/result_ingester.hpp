@@ -0,0 +1,85 @@
+#ifndef RESULT_INGESTER_HPP
+#define RESULT_INGESTER_HPP
+
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <cstdint>
+
+// One parsed line of results.txt: MatchID, WinnerID, LoserID
+struct ResultEntry {
+    int matchID;
+    int winnerID;
+    int loserID;
+};
+
+// Incremental reader for an append-only results file.
+// It remembers how many bytes of the file it has consumed and only parses lines
+// appended since the last call, so the cost of a call scales with the new results
+// rather than the whole history. Processed match IDs are tracked in a bitmap
+// (with a hash set for IDs beyond it) to drop duplicate reports.
+//
+// A result only counts as processed once the caller confirms that it was applied.
+// Each read is settled by confirming, deferring or dropping every entry it returned
+// and then calling commit(): deferred entries (e.g. a knockout match whose players are
+// not known yet) are returned again by the next read, dropped ones are gone.
+//
+// The state survives restarts through two files next to the results file:
+//   <results>.checkpoint - consumed byte offset, a signature of the last consumed bytes
+//                          and the deferred results
+//   <results>.processed  - append-only log of processed match IDs
+// If the results file is truncated or rewritten, the signature no longer matches and
+// reading restarts from the top of the file; already processed IDs are still skipped.
+class ResultIngester {
+public:
+    ResultIngester();
+
+    // Appends the deferred results and then every complete, not yet processed result
+    // added to the file since the last call to 'out'. Returns false if the results
+    // file cannot be opened.
+    bool readNewResults(const char* resultsFilename, std::vector<ResultEntry>& out);
+
+    // Settling the entries of the last read: confirmResult marks a result as applied,
+    // deferResult keeps it for the next read; entries that get neither are dropped
+    void confirmResult(const ResultEntry& entry);
+    void deferResult(const ResultEntry& entry);
+
+    // Persists the last read: the consumed offset, the deferred results and the newly
+    // confirmed IDs
+    void commit();
+
+    // Forgets the processed and deferred results with IDs in [firstID, lastID], for
+    // match IDs that were just handed out to new matches
+    void forgetProcessed(const char* resultsFilename, int firstID, int lastID);
+
+    // Forgets the consumed offset and processed IDs and deletes the persisted checkpoint
+    void reset(const char* resultsFilename);
+
+private:
+    std::string attachedFile;    // Results file the current state belongs to
+    std::int64_t consumedBytes;  // Bytes of the results file already parsed
+    std::string tailSignature;   // Last bytes consumed, used to detect rewrites
+
+    std::vector<std::uint64_t> processedBits; // Bitmap of processed IDs below bitmapLimit
+    std::unordered_set<int> processedOverflow; // Processed IDs outside the bitmap range
+    static const int bitmapLimit = 1 << 22;
+
+    std::vector<ResultEntry> deferred;    // Results to hand out again on the next read
+    std::vector<ResultEntry> nowDeferred; // Results deferred since the last read
+    std::vector<int> newlyProcessed;      // IDs confirmed since the last commit
+
+    // Loads the persisted state for a results file if it is not the attached one
+    void attach(const char* resultsFilename);
+
+    bool isProcessed(int matchID) const;
+    void markProcessed(int matchID);
+    void clearProcessed(int matchID);
+
+    // Persists the offset/signature/deferred results and appends the newly processed IDs to the log
+    void saveCheckpoint();
+
+    std::string checkpointFilename() const { return attachedFile + ".checkpoint"; }
+    std::string processedFilename() const { return attachedFile + ".processed"; }
+};
+
+#endif // RESULT_INGESTER_HPP
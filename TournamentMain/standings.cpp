@@ -0,0 +1,203 @@
+#include "standings.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h> // SSE2 intrinsics
+#define STANDINGS_USE_SSE2 1
+#endif
+
+namespace {
+
+#ifdef STANDINGS_USE_SSE2
+// Clamps four signed ints to [lo, hi] (SSE2 has no packed 32-bit min/max)
+inline __m128i clampInt32x4(__m128i v, __m128i lo, __m128i hi) {
+    __m128i belowLo = _mm_cmpgt_epi32(lo, v);
+    v = _mm_or_si128(_mm_and_si128(belowLo, lo), _mm_andnot_si128(belowLo, v));
+    __m128i aboveHi = _mm_cmpgt_epi32(v, hi);
+    return _mm_or_si128(_mm_and_si128(aboveHi, hi), _mm_andnot_si128(aboveHi, v));
+}
+
+// Adds the four lanes of v together
+inline int horizontalSum(__m128i v) {
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(v);
+}
+#endif
+
+} // namespace
+
+void StandingsStore::clear() {
+    playerIDs.clear();
+    wins.clear();
+    losses.clear();
+    priorities.clear();
+    groupIDs.clear();
+    handles.clear();
+    changedSlots.clear();
+    changedFlags.clear();
+}
+
+void StandingsStore::reserve(int count) {
+    size_t n = static_cast<size_t>(count);
+    playerIDs.reserve(n);
+    wins.reserve(n);
+    losses.reserve(n);
+    priorities.reserve(n);
+    groupIDs.reserve(n);
+    handles.reserve(n);
+    changedFlags.reserve(n);
+}
+
+int StandingsStore::addPlayer(Player* player) {
+    int slot = size();
+    playerIDs.push_back(player->playerID);
+    wins.push_back(player->wins);
+    losses.push_back(player->losses);
+    priorities.push_back(player->priority);
+    groupIDs.push_back(player->groupID);
+    handles.push_back(player);
+    changedFlags.push_back(0);
+    player->standingsSlot = slot;
+    return slot;
+}
+
+void StandingsStore::recordWin(int slot) {
+    handles[slot]->wins = ++wins[slot];
+    markChanged(slot);
+}
+
+void StandingsStore::recordLoss(int slot) {
+    handles[slot]->losses = ++losses[slot];
+    markChanged(slot);
+}
+
+void StandingsStore::setGroup(int slot, int groupID) {
+    if (groupIDs[slot] == groupID) return;
+    groupIDs[slot] = groupID;
+    handles[slot]->groupID = groupID;
+    markChanged(slot);
+}
+
+void StandingsStore::markChanged(int slot) {
+    if (!changedFlags[slot]) {
+        changedFlags[slot] = 1;
+        changedSlots.push_back(slot);
+    }
+}
+
+void StandingsStore::takeChangedSlots(std::vector<int>& out) {
+    out.clear();
+    out.swap(changedSlots);
+    for (size_t i = 0; i < out.size(); ++i) {
+        changedFlags[out[i]] = 0;
+    }
+}
+
+void StandingsStore::computeRankingKeys(std::uint64_t* keys) const {
+    const int n = size();
+    const int fieldMax = (1 << 21) - 1;
+    const int priorityBias = 1 << 20;
+    int i = 0;
+
+#ifdef STANDINGS_USE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i vFieldMax = _mm_set1_epi32(fieldMax);
+    const __m128i vBias = _mm_set1_epi32(priorityBias);
+    const __m128i vPriorityLo = _mm_set1_epi32(-priorityBias);
+    const __m128i vPriorityHi = _mm_set1_epi32(fieldMax - priorityBias);
+    for (; i + 4 <= n; i += 4) {
+        __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&wins[i]));
+        __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&losses[i]));
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&priorities[i]));
+
+        // Same field layout as makeRankingKey: wins << 42 | (max - losses) << 21 | biased priority
+        w = clampInt32x4(w, zero, vFieldMax);
+        l = _mm_sub_epi32(vFieldMax, clampInt32x4(l, zero, vFieldMax));
+        p = _mm_add_epi32(clampInt32x4(p, vPriorityLo, vPriorityHi), vBias);
+
+        // Widen the non-negative 32-bit fields to 64-bit lanes and combine them
+        __m128i keysLo = _mm_or_si128(
+            _mm_or_si128(_mm_slli_epi64(_mm_unpacklo_epi32(w, zero), 42), _mm_slli_epi64(_mm_unpacklo_epi32(l, zero), 21)),
+            _mm_unpacklo_epi32(p, zero));
+        __m128i keysHi = _mm_or_si128(
+            _mm_or_si128(_mm_slli_epi64(_mm_unpackhi_epi32(w, zero), 42), _mm_slli_epi64(_mm_unpackhi_epi32(l, zero), 21)),
+            _mm_unpackhi_epi32(p, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&keys[i]), keysLo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&keys[i + 2]), keysHi);
+    }
+#endif
+
+    for (; i < n; ++i) {
+        keys[i] = makeRankingKey(wins[i], losses[i], priorities[i]);
+    }
+}
+
+void StandingsStore::computeWinPercentages(float* percentages) const {
+    const int n = size();
+    int i = 0;
+
+#ifdef STANDINGS_USE_SSE2
+    const __m128 hundred = _mm_set1_ps(100.0f);
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 4 <= n; i += 4) {
+        __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&wins[i]));
+        __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&losses[i]));
+        __m128i played = _mm_add_epi32(w, l);
+        __m128 pct = _mm_div_ps(_mm_mul_ps(_mm_cvtepi32_ps(w), hundred), _mm_cvtepi32_ps(played));
+        // Lanes with no games played divided by zero; mask them back to 0
+        __m128 hasPlayed = _mm_castsi128_ps(_mm_cmpgt_epi32(played, zero));
+        _mm_storeu_ps(&percentages[i], _mm_and_ps(pct, hasPlayed));
+    }
+#endif
+
+    for (; i < n; ++i) {
+        int played = wins[i] + losses[i];
+        percentages[i] = played > 0 ? (wins[i] * 100.0f) / played : 0.0f;
+    }
+}
+
+void StandingsStore::computeGroupTotals(int groupID, int& totalWins, int& totalLosses) const {
+    const int n = size();
+    int i = 0;
+    totalWins = 0;
+    totalLosses = 0;
+
+#ifdef STANDINGS_USE_SSE2
+    const __m128i target = _mm_set1_epi32(groupID);
+    __m128i accWins = _mm_setzero_si128();
+    __m128i accLosses = _mm_setzero_si128();
+    for (; i + 4 <= n; i += 4) {
+        __m128i g = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&groupIDs[i]));
+        __m128i inGroup = _mm_cmpeq_epi32(g, target);
+        accWins = _mm_add_epi32(accWins, _mm_and_si128(inGroup, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&wins[i]))));
+        accLosses = _mm_add_epi32(accLosses, _mm_and_si128(inGroup, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&losses[i]))));
+    }
+    totalWins = horizontalSum(accWins);
+    totalLosses = horizontalSum(accLosses);
+#endif
+
+    for (; i < n; ++i) {
+        if (groupIDs[i] == groupID) {
+            totalWins += wins[i];
+            totalLosses += losses[i];
+        }
+    }
+}
+
+void StandingsStore::collectRankEntries(std::vector<RankEntry>& out) const {
+    const int n = size();
+    std::vector<std::uint64_t> keys(static_cast<size_t>(n));
+    if (n > 0) {
+        computeRankingKeys(keys.data());
+    }
+
+    out.clear();
+    out.reserve(static_cast<size_t>(n));
+    for (int i = 0; i < n; ++i) {
+        RankEntry entry;
+        entry.key = keys[i];
+        entry.order = i;
+        entry.player = handles[i];
+        out.push_back(entry);
+    }
+}
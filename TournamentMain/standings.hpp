@@ -0,0 +1,64 @@
+#ifndef STANDINGS_HPP
+#define STANDINGS_HPP
+
+#include <vector>    // Contiguous per-stat columns
+#include <cstdint>   // For packed ranking keys
+#include "player.hpp"
+#include "ranking.hpp"
+
+// Columnar (struct-of-arrays) store for the hot standings data of every player.
+// Each stat lives in its own contiguous int array indexed by standings slot, so
+// ranking and standings passes stream through plain ints instead of dragging the
+// names, times and status codes of each Player node through the cache.
+// The store is authoritative; the Player node fields are kept as a mirror for display.
+class StandingsStore {
+public:
+    std::vector<int> playerIDs;  // playerID per slot
+    std::vector<int> wins;       // Wins per slot
+    std::vector<int> losses;     // Losses per slot
+    std::vector<int> priorities; // Seeding priority per slot
+    std::vector<int> groupIDs;   // Group stage group per slot
+    std::vector<Player*> handles; // Cold player data (name, status, ...) per slot
+    std::vector<int> changedSlots;  // Slots whose stats changed since the last takeChangedSlots()
+    std::vector<char> changedFlags; // Per slot: already listed in changedSlots
+
+    // Removes every row
+    void clear();
+
+    // Makes room for 'count' rows without reallocating
+    void reserve(int count);
+
+    // Appends a row for the player and records its slot on the node
+    int addPlayer(Player* player);
+
+    // Number of rows in the store
+    int size() const { return static_cast<int>(playerIDs.size()); }
+
+    // Stat updates, mirrored onto the Player node
+    void recordWin(int slot);
+    void recordLoss(int slot);
+    void setGroup(int slot, int groupID);
+
+    // Moves the list of slots changed since the previous call into 'out'
+    void takeChangedSlots(std::vector<int>& out);
+
+    // === Bulk kernels (SSE2 where available, scalar otherwise) ===
+
+    // Writes the packed makeRankingKey() value of every slot into keys[0..size)
+    void computeRankingKeys(std::uint64_t* keys) const;
+
+    // Writes each slot's win percentage (0-100, 0 if no games played) into percentages[0..size)
+    void computeWinPercentages(float* percentages) const;
+
+    // Sums the wins and losses of every player in the given group
+    void computeGroupTotals(int groupID, int& totalWins, int& totalLosses) const;
+
+    // Fills 'out' with one ranking handle per slot, using the bulk key kernel
+    void collectRankEntries(std::vector<RankEntry>& out) const;
+
+private:
+    // Records that a slot needs to be written out again
+    void markChanged(int slot);
+};
+
+#endif // STANDINGS_HPP
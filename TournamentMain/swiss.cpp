@@ -0,0 +1,160 @@
+#include "swiss.hpp"
+#include <algorithm> // For std::sort and std::find
+
+void SwissPairingEngine::reset(int playerCount) {
+    opponents.assign(static_cast<size_t>(playerCount), std::vector<int>());
+    byeTaken.assign(static_cast<size_t>(playerCount), 0);
+    roundsPaired = 0;
+}
+
+bool SwissPairingEngine::havePlayed(int a, int b) const {
+    // Scan the shorter history; each list holds one entry per round
+    const std::vector<int>& history = opponents[a].size() <= opponents[b].size() ? opponents[a] : opponents[b];
+    int other = opponents[a].size() <= opponents[b].size() ? b : a;
+    return std::find(history.begin(), history.end(), other) != history.end();
+}
+
+void SwissPairingEngine::recordPairing(int a, int b) {
+    opponents[a].push_back(b);
+    opponents[b].push_back(a);
+}
+
+int SwissPairingEngine::pairRound(const std::vector<int>& scores, const std::vector<int>& ratings, std::vector<SwissPairing>& pairings) {
+    pairings.clear();
+    int n = static_cast<int>(opponents.size());
+    if (n < 2) return 0;
+    pairings.reserve(static_cast<size_t>(n / 2 + 1));
+
+    // Rank the field: score, then rating, then index for a stable order
+    std::vector<int> ranked(static_cast<size_t>(n));
+    for (int i = 0; i < n; ++i) ranked[i] = i;
+    std::sort(ranked.begin(), ranked.end(), [&scores, &ratings](int a, int b) {
+        if (scores[a] != scores[b]) return scores[a] > scores[b];
+        if (ratings[a] != ratings[b]) return ratings[a] > ratings[b];
+        return a < b;
+    });
+
+    // Odd field: the lowest-ranked player without a bye sits out (the lowest overall if everyone has had one)
+    if (n % 2 != 0) {
+        int byePosition = n - 1;
+        for (int pos = n - 1; pos >= 0; --pos) {
+            if (!byeTaken[ranked[pos]]) {
+                byePosition = pos;
+                break;
+            }
+        }
+        int byePlayer = ranked[byePosition];
+        ranked.erase(ranked.begin() + byePosition);
+        byeTaken[byePlayer] = 1;
+        SwissPairing bye;
+        bye.player1 = byePlayer;
+        bye.player2 = -1;
+        pairings.push_back(bye);
+    }
+
+    // Walk the score groups from the top; floaters join the front of the next group
+    std::vector<int> pool;
+    std::vector<int> floaters;
+    size_t start = 0;
+    while (start < ranked.size()) {
+        size_t end = start;
+        while (end < ranked.size() && scores[ranked[end]] == scores[ranked[start]]) {
+            end++;
+        }
+        pool.swap(floaters);
+        pool.insert(pool.end(), ranked.begin() + start, ranked.begin() + end);
+        floaters.clear();
+        pairScoreGroup(pool, pairings, floaters);
+        start = end;
+    }
+
+    // Whoever is still unpaired after the last group is paired greedily, allowing a
+    // rematch only when no fresh opponent is left
+    int rematches = 0;
+    std::vector<char> taken(floaters.size(), 0);
+    for (size_t i = 0; i < floaters.size(); ++i) {
+        if (taken[i]) continue;
+        size_t partner = floaters.size();
+        for (size_t j = i + 1; j < floaters.size(); ++j) {
+            if (!taken[j] && !havePlayed(floaters[i], floaters[j])) {
+                partner = j;
+                break;
+            }
+        }
+        bool rematch = false;
+        if (partner == floaters.size()) {
+            for (size_t j = i + 1; j < floaters.size(); ++j) {
+                if (!taken[j]) {
+                    partner = j;
+                    rematch = true;
+                    break;
+                }
+            }
+        }
+        if (partner == floaters.size()) break; // Cannot happen with an even field
+        taken[i] = taken[partner] = 1;
+        SwissPairing pairing;
+        pairing.player1 = floaters[i];
+        pairing.player2 = floaters[partner];
+
+        // Before accepting a rematch, try swapping partners with one of the lowest
+        // pairings already made (the players closest in score)
+        for (size_t k = pairings.size(); rematch && k-- > 0;) {
+            SwissPairing& other = pairings[k];
+            if (other.player2 < 0) continue; // The bye
+            if (!havePlayed(pairing.player1, other.player1) && !havePlayed(pairing.player2, other.player2)) {
+                std::swap(pairing.player2, other.player1);
+                rematch = false;
+            }
+            else if (!havePlayed(pairing.player1, other.player2) && !havePlayed(pairing.player2, other.player1)) {
+                std::swap(pairing.player2, other.player2);
+                rematch = false;
+            }
+        }
+        if (rematch) rematches++;
+        pairings.push_back(pairing);
+    }
+
+    for (size_t i = 0; i < pairings.size(); ++i) {
+        if (pairings[i].player2 >= 0) {
+            recordPairing(pairings[i].player1, pairings[i].player2);
+        }
+    }
+    roundsPaired++;
+    return rematches;
+}
+
+void SwissPairingEngine::pairScoreGroup(std::vector<int>& pool, std::vector<SwissPairing>& pairings, std::vector<int>& floaters) {
+    size_t half = pool.size() / 2;
+    size_t bottomCount = pool.size() - half;
+    std::vector<char> bottomUsed(bottomCount, 0);
+
+    // Top half player i meets bottom half player i; on a rematch try the following
+    // bottom-half players, then the ones above
+    for (size_t i = 0; i < half; ++i) {
+        int player = pool[i];
+        size_t match = bottomCount;
+        for (size_t step = 0; step < bottomCount; ++step) {
+            size_t j = (i + step) % bottomCount;
+            if (!bottomUsed[j] && !havePlayed(player, pool[half + j])) {
+                match = j;
+                break;
+            }
+        }
+        if (match == bottomCount) {
+            floaters.push_back(player); // No fresh opponent here: float down
+            continue;
+        }
+        bottomUsed[match] = 1;
+        SwissPairing pairing;
+        pairing.player1 = player;
+        pairing.player2 = pool[half + match];
+        pairings.push_back(pairing);
+    }
+
+    for (size_t j = 0; j < bottomCount; ++j) {
+        if (!bottomUsed[j]) {
+            floaters.push_back(pool[half + j]);
+        }
+    }
+}
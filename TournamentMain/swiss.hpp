@@ -0,0 +1,54 @@
+#ifndef SWISS_HPP
+#define SWISS_HPP
+
+#include <vector>
+
+// One pairing of a Swiss round, in player indices (player2 is -1 for the bye)
+struct SwissPairing {
+    int player1;
+    int player2;
+};
+
+// Swiss-system pairing engine. Players are dense indices 0..n-1 (the caller keeps the
+// index -> player mapping); scores and tie-break ratings are passed in each round, so
+// the engine only keeps the history it needs: each player's opponents and whether they
+// have had a bye.
+//
+// Each round follows the Dutch system: players are ranked by score (then rating), each
+// score group is split into a top and a bottom half and the top half is paired against
+// the bottom half in order. A player whose natural opponent is a rematch tries the next
+// bottom-half player; players left without a partner float down into the next score
+// group. With an odd field the lowest-ranked player who has not had a bye sits out.
+// Players still unpaired after the last group are paired among themselves; a forced
+// rematch there is avoided when possible by swapping partners with a lower pairing.
+class SwissPairingEngine {
+public:
+    SwissPairingEngine() : roundsPaired(0) {}
+
+    // Starts a new Swiss event for playerCount players
+    void reset(int playerCount);
+
+    // Pairs the next round and records it in the history. scores and ratings are indexed
+    // by player. Returns the number of rematches that could not be avoided (normally 0).
+    int pairRound(const std::vector<int>& scores, const std::vector<int>& ratings, std::vector<SwissPairing>& pairings);
+
+    // True if the two players have already met
+    bool havePlayed(int a, int b) const;
+
+    bool hadBye(int player) const { return byeTaken[player] != 0; }
+    int getRoundsPaired() const { return roundsPaired; }
+    int getPlayerCount() const { return static_cast<int>(opponents.size()); }
+
+private:
+    std::vector<std::vector<int>> opponents; // Per player, one entry per round played (at most a few dozen)
+    std::vector<char> byeTaken;               // Per player
+    int roundsPaired;
+
+    // Pairs one score group (plus the floaters from above); players left over are
+    // returned in 'floaters' for the next group
+    void pairScoreGroup(std::vector<int>& pool, std::vector<SwissPairing>& pairings, std::vector<int>& floaters);
+
+    void recordPairing(int a, int b);
+};
+
+#endif // SWISS_HPP
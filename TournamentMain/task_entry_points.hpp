@@ -2,6 +2,9 @@
 #ifndef TASK_ENTRY_POINTS_HPP
 #define TASK_ENTRY_POINTS_HPP
 
+#include <string>
+#include <sstream>
+
 // Declare the entry point functions for each task
 void Task1Main(); // For Match Scheduling & Player Progression
 void Task2Main(); // For Tournament Registration & Player Queueing
@@ -9,4 +12,19 @@ void Task3Main(); // For Live Stream & Spectator Queue Management
 void Task4Main(); // For Game Result Logging & Performance History
 void clearScreen();
 
-#endif // TASK_ENTRY_POINTS_HPP
\ No newline at end of file
+// Outcome of one batch mode command
+enum BatchStatus {
+    BATCH_UNKNOWN, // Not one of this task's commands
+    BATCH_DONE,    // The command ran
+    BATCH_FAILED   // The command was rejected or failed (the reason has been printed)
+};
+
+// Batch mode handlers: each task runs the script commands it owns, with 'args' holding
+// the rest of the line. They call the same code as the menus, minus prompts and pauses,
+// and keep their task's state (queues, loaded files) from one command to the next.
+BatchStatus Task1BatchCommand(const std::string& command, std::istringstream& args);
+BatchStatus Task2BatchCommand(const std::string& command, std::istringstream& args);
+BatchStatus Task3BatchCommand(const std::string& command, std::istringstream& args);
+BatchStatus Task4BatchCommand(const std::string& command, std::istringstream& args);
+
+#endif // TASK_ENTRY_POINTS_HPP
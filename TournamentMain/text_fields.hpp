@@ -0,0 +1,52 @@
+#ifndef TEXT_FIELDS_HPP
+#define TEXT_FIELDS_HPP
+
+#include <charconv>  // For std::from_chars
+#include <cstring>   // For memcpy
+#include <algorithm> // For std::min
+#include <cstddef>   // For size_t
+
+// Helpers for tokenizing comma-separated lines in place, without building strings.
+
+// A field of a line, pointing straight into the source buffer (not null-terminated)
+struct FieldRange {
+    const char* begin;
+    const char* end;
+};
+
+// Splits [begin, end) at commas into at most maxFields ranges; returns the field count,
+// or maxFields + 1 if the line has more fields than allowed
+inline int splitFields(const char* begin, const char* end, FieldRange* fields, int maxFields) {
+    int count = 0;
+    const char* fieldStart = begin;
+    for (const char* c = begin; ; ++c) {
+        if (c == end || *c == ',') {
+            if (count == maxFields) return maxFields + 1;
+            fields[count].begin = fieldStart;
+            fields[count].end = c;
+            count++;
+            if (c == end) break;
+            fieldStart = c + 1;
+        }
+    }
+    return count;
+}
+
+// Parses a whole field as an int with std::from_chars, ignoring surrounding spaces
+inline bool parseIntField(const FieldRange& field, int& value) {
+    const char* begin = field.begin;
+    const char* end = field.end;
+    while (begin < end && (*begin == ' ' || *begin == '\t')) ++begin;
+    while (end > begin && (end[-1] == ' ' || end[-1] == '\t')) --end;
+    std::from_chars_result result = std::from_chars(begin, end, value);
+    return result.ec == std::errc() && result.ptr == end && begin != end;
+}
+
+// Copies a field into a fixed-size char array, truncating if needed
+inline void copyField(const FieldRange& field, char* dest, size_t destSize) {
+    size_t length = std::min(static_cast<size_t>(field.end - field.begin), destSize - 1);
+    memcpy(dest, field.begin, length);
+    dest[length] = '\0';
+}
+
+#endif // TEXT_FIELDS_HPP
@@ -7,6 +7,10 @@
 #include <ctime>
 #include <iomanip>
 #include "task_entry_points.hpp"
+#include "perf_stats.hpp"
+#include "registration_journal.hpp"
+#include "id_registry.hpp"
+#include "withdrawal_store.hpp"
 
 using namespace std;
 
@@ -27,142 +31,222 @@ bool isValidRegType(const string& s) {
     return s == "earlybird" || s == "wildcard" || s == "normal";
 }
 
-string getCurrentDateTime() {
-    time_t now = time(nullptr);
-    tm localTime;
+// Priority that goes with a registration type (wildcards are seeded first)
+int priorityForRegType(RegistrationType type) {
+    if (type == REG_WILDCARD) return 1;
+    if (type == REG_EARLYBIRD) return 2;
+    return 3; // normal
+}
 
-#ifdef _WIN32
-    localtime_s(&localTime, &now);
-#else
-    localtime_r(&now, &localTime);
-#endif
+void PriorityQueue::reserve(int count) {
+    players.reserve(static_cast<size_t>(count));
+    slotPosition.reserve(static_cast<size_t>(count));
+    heap.reserve(static_cast<size_t>(count));
+    idToSlot.reserve(count);
+}
 
-    int hour = localTime.tm_hour;
-    string am_pm = "AM";
+void PriorityQueue::clear() {
+    players.clear();
+    slotPosition.clear();
+    freeSlots.clear();
+    heap.clear();
+    idToSlot.clear();
+    nextSequence = 0;
+}
 
-    if (hour == 0) hour = 12;
-    else if (hour == 12) am_pm = "PM";
-    else if (hour > 12) {
-        hour -= 12;
-        am_pm = "PM";
+void PriorityQueue::insert(const Player& player) {
+    int slot = idToSlot.find(player.playerID);
+    if (slot >= 0) {
+        // Already queued: update the record in place and re-position only if needed
+        int oldPriority = players[slot].priority;
+        players[slot] = player;
+        players[slot].priority = oldPriority;
+        if (player.priority != oldPriority) {
+            changePriority(player.playerID, player.priority);
+        }
+        return;
     }
 
-    stringstream ss;
-    ss << 1900 + localTime.tm_year << "-"
-        << setw(2) << setfill('0') << 1 + localTime.tm_mon << "-"
-        << setw(2) << setfill('0') << localTime.tm_mday << " "
-        << setw(2) << setfill('0') << hour << ":"
-        << setw(2) << setfill('0') << localTime.tm_min << ":"
-        << setw(2) << setfill('0') << localTime.tm_sec << " "
-        << am_pm;
-
-    return ss.str();
-}
-
-Player::Player() {
-    id = 0;
-    name = "";
-    registrationTime = "";
-    status = "";
-    priority = 0;
-    regType = "";
-}
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+        players[slot] = player;
+    }
+    else {
+        slot = static_cast<int>(players.size());
+        players.push_back(player);
+        slotPosition.push_back(-1);
+    }
+    idToSlot.insert(player.playerID, slot);
 
-Player::Player(int id, string name, string regTime, string status, int priority, string regType)
-    : id(id), name(name), registrationTime(regTime), status(status), priority(priority), regType(regType) {
+    HeapEntry entry = { makeKey(player.priority, nextSequence++), slot };
+    heap.push_back(entry);
+    place(static_cast<int>(heap.size()) - 1, entry);
+    siftUp(static_cast<int>(heap.size()) - 1);
 }
 
-PriorityQueue::PriorityQueue() {
-    size = 0;
-    capacity = 10;
-    queue = new Player[capacity];
-}
+void PriorityQueue::insertBulk(const std::vector<Player>& batch) {
+    reserve(getSize() + static_cast<int>(batch.size()));
+    for (size_t i = 0; i < batch.size(); ++i) {
+        const Player& player = batch[i];
+        int slot = idToSlot.find(player.playerID);
+        if (slot >= 0) {
+            // Already queued: same rule as insert(), the heapify below re-positions it
+            int position = slotPosition[slot];
+            std::uint32_t sequence = static_cast<std::uint32_t>(heap[position].key);
+            players[slot] = player;
+            heap[position].key = makeKey(player.priority, sequence);
+            continue;
+        }
 
-PriorityQueue::~PriorityQueue() {
-    delete[] queue;
-}
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+            players[slot] = player;
+        }
+        else {
+            slot = static_cast<int>(players.size());
+            players.push_back(player);
+            slotPosition.push_back(-1);
+        }
+        idToSlot.insert(player.playerID, slot);
 
-void PriorityQueue::resize() {
-    capacity *= 2;
-    Player* newQueue = new Player[capacity];
-    for (int i = 0; i < size; i++) {
-        newQueue[i] = queue[i];
+        HeapEntry entry = { makeKey(player.priority, nextSequence++), slot };
+        heap.push_back(entry);
+        place(static_cast<int>(heap.size()) - 1, entry);
     }
-    delete[] queue;
-    queue = newQueue;
-}
 
-void PriorityQueue::insert(Player player) {
-    if (size == capacity) {
-        resize();
-    }
-    int i = size - 1;
-    while (i >= 0 && queue[i].priority > player.priority) {
-        queue[i + 1] = queue[i];
-        i--;
+    // Floyd's heapify: sift down every internal node, last parent first (O(n))
+    if (heap.size() < 2) return;
+    for (int position = (static_cast<int>(heap.size()) - 2) / ARITY; position >= 0; --position) {
+        siftDown(position);
     }
-    queue[i + 1] = player;
-    size++;
 }
 
 Player PriorityQueue::remove() {
     if (isEmpty()) {
         throw runtime_error("Queue is empty");
     }
-    return queue[--size];
+    Player served = players[heap[0].slot];
+    removeAt(0);
+    return served;
 }
 
-bool PriorityQueue::isEmpty() {
-    return size == 0;
+bool PriorityQueue::removeByID(int id, Player* removed) {
+    int slot = idToSlot.find(id);
+    if (slot < 0) return false;
+    if (removed != nullptr) *removed = players[slot];
+    removeAt(slotPosition[slot]);
+    return true;
 }
 
-void loadPlayersFromFile(PriorityQueue& pq) {
-    ifstream inputFile("players.txt");
-    if (!inputFile.is_open()) {
-        cout << "Error: Could not open players.txt file.\n";
-        return;
-    }
+bool PriorityQueue::changePriority(int id, int newPriority) {
+    int slot = idToSlot.find(id);
+    if (slot < 0) return false;
+    int position = slotPosition[slot];
+    std::uint64_t oldKey = heap[position].key;
+    players[slot].priority = newPriority;
+    heap[position].key = makeKey(newPriority, static_cast<std::uint32_t>(oldKey)); // Keeps the arrival order
+    if (heap[position].key < oldKey) siftUp(position);
+    else siftDown(position);
+    return true;
+}
+
+const Player* PriorityQueue::find(int id) const {
+    int slot = idToSlot.find(id);
+    return slot < 0 ? nullptr : &players[slot];
+}
 
-    string line;
-    if (inputFile.peek() != EOF) {
-        //getline(inputFile, line); // skip header if present
+void PriorityQueue::collectInOrder(std::vector<const Player*>& out) const {
+    std::vector<HeapEntry> ordered(heap);
+    std::sort(ordered.begin(), ordered.end(), [](const HeapEntry& a, const HeapEntry& b) { return a.key < b.key; });
+    out.clear();
+    out.reserve(ordered.size());
+    for (size_t i = 0; i < ordered.size(); ++i) {
+        out.push_back(&players[ordered[i].slot]);
     }
+}
 
-    while (getline(inputFile, line)) {
-        stringstream ss(line);
-        string id_str, name, regTime, status, regType, priority_str;
+// Takes the entry at 'position' out of the heap and frees its slot
+void PriorityQueue::removeAt(int position) {
+    int slot = heap[position].slot;
+    idToSlot.erase(players[slot].playerID);
+    slotPosition[slot] = -1;
+    freeSlots.push_back(slot);
+
+    HeapEntry last = heap.back();
+    heap.pop_back();
+    if (position == static_cast<int>(heap.size())) return; // Removed the last entry
+    std::uint64_t removedKey = heap[position].key;
+    place(position, last);
+    if (last.key < removedKey) siftUp(position);
+    else siftDown(position);
+}
 
-        getline(ss, id_str, ',');
-        getline(ss, name, ',');
-        getline(ss, regTime, ',');
-        getline(ss, status, ',');
-        getline(ss, regType, ',');
-        getline(ss, priority_str, ',');
+void PriorityQueue::siftUp(int position) {
+    HeapEntry entry = heap[position];
+    while (position > 0) {
+        int parent = (position - 1) / ARITY;
+        if (heap[parent].key <= entry.key) break;
+        place(position, heap[parent]);
+        position = parent;
+    }
+    place(position, entry);
+}
 
-        id_str = trim(id_str);
-        name = trim(name);
-        regTime = trim(regTime);
-        status = trim(status);
-        regType = trim(regType);
-        priority_str = trim(priority_str);
+void PriorityQueue::siftDown(int position) {
+    HeapEntry entry = heap[position];
+    int count = static_cast<int>(heap.size());
+    while (true) {
+        int firstChild = position * ARITY + 1;
+        if (firstChild >= count) break;
+        int lastChild = std::min(firstChild + ARITY, count);
+        int best = firstChild;
+        for (int child = firstChild + 1; child < lastChild; ++child) {
+            if (heap[child].key < heap[best].key) best = child;
+        }
+        if (heap[best].key >= entry.key) break;
+        place(position, heap[best]);
+        position = best;
+    }
+    place(position, entry);
+}
 
-        if (id_str.empty() || name.empty() || status.empty() || regType.empty() || priority_str.empty())
-            continue;
+// Loads the registration queue (the players.txt snapshot plus the journal events after it)
+// and rebuilds the ID registry from it, the check-in log and the withdrawal store
+void loadPlayersFromFile(PriorityQueue& pq) {
+    PERF_SCOPE("registration.loadPlayersFromFile");
+    registrationJournal().load(pq);
+    idRegistry().load(pq, "checked_in.txt", withdrawalStore());
+}
+// Queues a new registration and records it in the registration journal (no prompts).
+// Returns false if the name or registration type is invalid or the file cannot be written.
+bool addPlayerRegistration(PriorityQueue& pq, int id, const string& name, const string& regType) {
+    PERF_SCOPE("registration.addPlayerRegistration");
+    if (!isAlphaString(name)) {
+        cout << "Invalid input! Name must contain letters only.\n";
+        return false;
+    }
+    if (!isValidRegType(regType)) {
+        cout << "Invalid Registration Type! Must be 'wildcard', 'earlybird', or 'normal'.\n";
+        return false;
+    }
 
-        int id = stoi(id_str);
-        int priority = stoi(priority_str);
+    RegistrationType type = internRegType(regType);
+    Player newPlayer(id, name, currentRegistrationTime(), STATUS_REGISTERED, priorityForRegType(type), type);
+    pq.insert(newPlayer);
+    idRegistry().update(id, IdRegistry::QUEUED);
 
-        // Insert player into the priority queue if they are registered
-        if (status == "Registered") {
-            pq.insert(Player(id, name, regTime, status, priority, regType));
-        }
+    if (!registrationJournal().recordRegistration(newPlayer, pq)) {
+        cout << "Error writing to the registration journal!\n";
+        return false;
     }
-    inputFile.close();
+    cout << "Player " << name << " registered successfully and has been saved to the players list.\n";
+    return true;
 }
+
 void registerPlayer(PriorityQueue& pq, int id) {
-   ;
-    
-    string firstName, lastName, regType, name;
+    string firstName, lastName, regType;
 
     
     while (true) {
@@ -198,31 +282,7 @@ void registerPlayer(PriorityQueue& pq, int id) {
         break;
     }
 
-    name = firstName + " " + lastName;
-
-    int priority = 3; // default normal
-    if (regType == "wildcard") priority = 1;
-    else if (regType == "earlybird") priority = 2;
-
-    string currentTime = getCurrentDateTime();
-
-    Player newPlayer(id, name, currentTime, "Registered", priority, regType);
-    pq.insert(newPlayer);
-
-    ofstream playersFile("players.txt", ios::app);
-    if (!playersFile) {
-        cout << "Error opening players.txt for writing!\n";
-    }
-    else {
-        playersFile << newPlayer.id << "," << newPlayer.name << "," << newPlayer.registrationTime << "," << newPlayer.status << "," << newPlayer.regType << "," << newPlayer.priority << "\n";
-        if (playersFile.fail()) {
-            cout << "Error writing to players.txt!\n";
-        }
-        else {
-            cout << "Player " << name << " registered successfully and has been saved to the players list.\n";
-        }
-        playersFile.close();
-    }
+    addPlayerRegistration(pq, id, firstName + " " + lastName, regType);
 
     cout << "Press Enter to return to the main menu...";
     cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // discard leftover input
@@ -231,79 +291,60 @@ void registerPlayer(PriorityQueue& pq, int id) {
     
 }
 
-bool parseDateTime(const string& datetimeStr, tm& outTm) {
-    istringstream ss(datetimeStr);
-    ss >> get_time(&outTm, "%Y-%m-%d %I:%M:%S %p");
-    return !ss.fail();
-}
-
-void checkInPlayer(PriorityQueue& pq, int id) {
-    bool found = false;
-    Player checkedInPlayer;
-    int removeIndex = -1;
-
-    for (int i = 0; i < pq.size; ++i) {
-        if (pq.queue[i].id == id) {
-            found = true;
-            checkedInPlayer = pq.queue[i];
-            removeIndex = i;
-            break;
-        }
-    }
-
-    if (!found) {
+// Checks a queued player in: moves them to checked_in.txt and journals the check-in.
+// Returns false if the player is not queued, is too late, or a file cannot be written.
+bool completeCheckIn(PriorityQueue& pq, int id) {
+    PERF_SCOPE("registration.completeCheckIn");
+    const Player* queued = pq.find(id);
+    if (queued == nullptr) {
         cout << "Player with ID " << id << " not found.\n";
-        return;
+        return false;
     }
+    Player checkedInPlayer = *queued;
 
-    tm regTm{};
-    if (!parseDateTime(checkedInPlayer.registrationTime, regTm)) {
+    if (checkedInPlayer.registrationTime == 0) {
         cout << "Error parsing registration time.\n";
-        return;
+        return false;
     }
 
-    time_t reg_time_t = mktime(&regTm);
-    time_t now = time(nullptr);
-    double diffMinutes = difftime(now, reg_time_t) / 60.0;
+    double diffMinutes = static_cast<double>(currentRegistrationTime() - checkedInPlayer.registrationTime) / 60.0;
 
     if (diffMinutes >= 30) {
         cout << "Check-in has been rejected  late by " << (int)diffMinutes << " minutes. Must check in within 30 minutes.\n";
-        return;
+        return false;
     }
 
     if (diffMinutes > 10) {
-        cout << "Warning: Player " << checkedInPlayer.name << " is checking in late (" << (int)diffMinutes << " minutes).\n";
+        cout << "Warning: Player " << checkedInPlayer.getName() << " is checking in late (" << (int)diffMinutes << " minutes).\n";
     }
 
-    checkedInPlayer.status = "CheckedIn";
-    checkedInPlayer.registrationTime = getCurrentDateTime();
+    checkedInPlayer.status = STATUS_CHECKED_IN;
+    checkedInPlayer.registrationTime = currentRegistrationTime();
 
     ofstream checkedInFile("checked_in.txt", ios::app);
     if (!checkedInFile) {
         cout << "Failed to open checked_in.txt\n";
-        return;
+        return false;
     }
-    checkedInFile << checkedInPlayer.id << "," << checkedInPlayer.name << "," << checkedInPlayer.registrationTime << ","
-        << checkedInPlayer.status << "," << checkedInPlayer.regType << "," << checkedInPlayer.priority << "\n";
+    writePlayerLine(checkedInFile, checkedInPlayer);
     checkedInFile.close();
 
-    for (int i = removeIndex; i < pq.size - 1; ++i) {
-        pq.queue[i] = pq.queue[i + 1];
+    pq.removeByID(id);
+    idRegistry().update(id, IdRegistry::CHECKED_IN, IdRegistry::QUEUED);
+
+    if (!registrationJournal().recordCheckIn(id, pq)) {
+        cout << "Failed to write the registration journal\n";
+        return false;
     }
-    pq.size--;
 
-    ofstream playersFile("players.txt");
-    if (!playersFile) {
-        cout << "Failed to open players.txt\n";
+    cout << "Player " << checkedInPlayer.getName() << " checked in successfully at " << formatRegistrationTime(checkedInPlayer.registrationTime) << ".\n";
+    return true;
+}
+
+void checkInPlayer(PriorityQueue& pq, int id) {
+    if (!completeCheckIn(pq, id)) {
         return;
     }
-    for (int i = 0; i < pq.size; ++i) {
-        Player& p = pq.queue[i];
-        playersFile << p.id << "," << p.name << "," << p.registrationTime << "," << p.status << "," << p.regType << "," << p.priority << "\n";
-    }
-    playersFile.close();
-
-    cout << "Player " << checkedInPlayer.name << " checked in successfully at " << checkedInPlayer.registrationTime << ".\n";
     cout << "Press Enter to return to the main menu...";
     cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // discard leftover input
     cin.get(); // wait for Enter key
@@ -311,60 +352,37 @@ void checkInPlayer(PriorityQueue& pq, int id) {
 }
 
 
-void withdrawPlayer(PriorityQueue& pq, int id) {
-    bool found = false;
-
-    // Open the withdrawals file for appending
-    ofstream withdrawFile("withdrawals.txt", ios::app);
-    if (!withdrawFile) {
-        cout << "Error opening withdrawals.txt for writing!\n";
-        return;
+// Marks a queued player as withdrawn: adds them to the withdrawal store and journals the
+// withdrawal. Returns false if the player is not queued or a file cannot be written.
+bool completeWithdrawal(PriorityQueue& pq, int id) {
+    PERF_SCOPE("registration.completeWithdrawal");
+    if (!pq.contains(id)) {
+        cout << "Player with ID " << id << " not found.\n";
+        return false;
     }
 
-    // Temporary queue to hold the remaining players
-    PriorityQueue tempPQ;
-
-    // Iterate over all players in the queue to find the withdrawn player
-    for (int i = 0; i < pq.size; ++i) {
-        Player& p = pq.queue[i];
-
-        if (p.id == id) {
-            // Player found, update their status to "Withdrawn"
-            p.status = "Withdrawn";
-
-            // Write the player to the withdrawals file
-            withdrawFile << p.id << "," << p.name << "," << p.registrationTime << "," << p.status << "," << p.regType << "," << p.priority << "\n";
-            cout << "Player " << p.name << " has been marked as Withdrawn and moved to withdrawals list.\n";
-            found = true;  // Mark player as found
-        }
-        else {
-            // If not the player to withdraw, keep the player in the temp queue
-            tempPQ.insert(p);
-        }
+    // Record the player in the withdrawal store (one append to withdrawals.txt)
+    Player withdrawn = *pq.find(id);
+    withdrawn.status = STATUS_WITHDRAWN;
+    if (!withdrawalStore().add(withdrawn)) {
+        cout << "Error opening withdrawals.txt for writing!\n";
+        return false;
     }
+    pq.removeByID(id);
+    idRegistry().update(id, IdRegistry::WITHDRAWN, IdRegistry::QUEUED);
+    cout << "Player " << withdrawn.getName() << " has been marked as Withdrawn and moved to withdrawals list.\n";
 
-    if (!found) {
-        cout << "Player with ID " << id << " not found.\n";
-        withdrawFile.close();
-        return;
+    if (!registrationJournal().recordWithdrawal(id, pq)) {
+        cout << "Error writing to the registration journal!\n";
+        return false;
     }
+    return true;
+}
 
-    // Rebuild the players.txt file with the remaining players
-    ofstream playersFile("players.txt");
-    if (!playersFile) {
-        cout << "Error opening players.txt for writing!\n";
-        withdrawFile.close();
+void withdrawPlayer(PriorityQueue& pq, int id) {
+    if (!completeWithdrawal(pq, id)) {
         return;
     }
-
-    // Write all players from the temp queue back into players.txt
-    for (int i = 0; i < tempPQ.size; ++i) {
-        Player& p = tempPQ.queue[i];
-        playersFile << p.id << "," << p.name << "," << p.registrationTime << "," << p.status << "," << p.regType << "," << p.priority << "\n";
-    }
-
-    withdrawFile.close();
-    playersFile.close();
     cout << "Press Enter to return to the main menu...";
     cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // discard leftover input
     cin.get(); // wait for Enter key
@@ -373,32 +391,57 @@ void withdrawPlayer(PriorityQueue& pq, int id) {
 }
 
 void printWithdrawnPlayers() {
-    std::ifstream withdrawFile("withdrawals.txt");
-    if (!withdrawFile) {
-        std::cout << "Error opening withdrawals.txt for reading!\n";
-        return;
-    }
-
-    std::string line;
+    vector<const Player*> withdrawn;
+    withdrawalStore().collect(withdrawn);
     std::cout << "List of withdrawn players:\n";
-    while (getline(withdrawFile, line)) {
-        std::cout << line << "\n";
+    std::string line;
+    for (size_t i = 0; i < withdrawn.size(); ++i) {
+        line.clear();
+        appendPlayerLine(line, *withdrawn[i]);
+        std::cout << line;
     }
-    withdrawFile.close();
 }
 
-void replacePlayer(PriorityQueue& pq, int /*unused*/, std::string /*unused*/, std::string /*unused*/) {
-    const int MAX_WITHDRAWN = 100;
-    int withdrawnIds[MAX_WITHDRAWN];
-    int count = 0;
+// Replaces a withdrawn player: removes them from the withdrawal store and registers the
+// replacement under the same ID. Returns false if the ID is not a withdrawn player,
+// the name or type is invalid, or a file cannot be written.
+bool completeReplacement(PriorityQueue& pq, int selectedId, const std::string& fullName, const std::string& regType) {
+    PERF_SCOPE("registration.completeReplacement");
+    if (!isAlphaString(fullName) || !isValidRegType(regType)) {
+        std::cout << "Invalid replacement player details! Name must contain letters only and type must be 'wildcard', 'earlybird', or 'normal'.\n";
+        return false;
+    }
 
-    std::ifstream withdrawFile("withdrawals.txt");
-    if (!withdrawFile) {
-        std::cout << "Error opening withdrawals.txt for reading!\n";
-        return;
+    // Tombstone the selected player's withdrawal record(s) in place
+    WithdrawalStore& withdrawals = withdrawalStore();
+    if (!withdrawals.contains(selectedId)) {
+        std::cout << "Player ID " << selectedId << " not found in withdrawn players.\n";
+        return false;
+    }
+    if (!withdrawals.remove(selectedId)) {
+        std::cout << "Error writing to withdrawals.txt!\n";
+        return false;
     }
 
-    std::string line;
+    RegistrationType type = internRegType(regType);
+    Player newPlayer(selectedId, fullName, currentRegistrationTime(), STATUS_REGISTERED, priorityForRegType(type), type);
+
+    pq.insert(newPlayer);
+    idRegistry().update(selectedId, IdRegistry::QUEUED, IdRegistry::WITHDRAWN);
+
+    if (!registrationJournal().recordReplacement(newPlayer, pq)) {
+        std::cout << "Error writing to the registration journal!\n";
+        return false;
+    }
+    std::cout << "Player " << fullName << " has been replaced the withdrawn player successfully and saved to the players list.\n";
+    return true;
+}
+
+void replacePlayer(PriorityQueue& pq, int /*unused*/, std::string /*unused*/, std::string /*unused*/) {
+    WithdrawalStore& withdrawals = withdrawalStore();
+    vector<const Player*> withdrawn;
+    withdrawals.collect(withdrawn);
+
     std::cout << "List of withdrawn players:\n";
     std::cout << std::left
         << std::setw(4) << "ID"
@@ -409,42 +452,15 @@ void replacePlayer(PriorityQueue& pq, int /*unused*/, std::string /*unused*/, st
         << " | Registered at\n";
     std::cout << "--------------------------------------------------------------------------------\n";
 
-    while (getline(withdrawFile, line) && count < MAX_WITHDRAWN) {
-        // Expected format: id,name,registrationTime,status,regType,priority
-        size_t pos[6];
-        pos[0] = line.find(',');
-        pos[1] = line.find(',', pos[0] + 1);
-        pos[2] = line.find(',', pos[1] + 1);
-        pos[3] = line.find(',', pos[2] + 1);
-        pos[4] = line.find(',', pos[3] + 1);
-
-        if (pos[0] == std::string::npos || pos[1] == std::string::npos || pos[2] == std::string::npos ||
-            pos[3] == std::string::npos || pos[4] == std::string::npos) {
-            // Malformed line, just print raw and continue
-            std::cout << line << "\n";
-            continue;
-        }
-
-        std::string idStr = line.substr(0, pos[0]);
-        std::string name = line.substr(pos[0] + 1, pos[1] - pos[0] - 1);
-        std::string registrationTime = line.substr(pos[1] + 1, pos[2] - pos[1] - 1);
-        std::string status = line.substr(pos[2] + 1, pos[3] - pos[2] - 1);
-        std::string regType = line.substr(pos[3] + 1, pos[4] - pos[3] - 1);
-        std::string priorityStr = line.substr(pos[4] + 1);
-
-        int id = atoi(idStr.c_str());
-        if (id > 0) {
-            withdrawnIds[count++] = id;
-
-            std::cout << std::setw(4) << id << " | "
-                << std::setw(20) << name << " | "
-                << std::setw(10) << status << " | "
-                << std::setw(10) << regType << " | "
-                << std::setw(8) << priorityStr << " | "
-                << registrationTime << "\n";
-        }
+    for (size_t i = 0; i < withdrawn.size(); ++i) {
+        const Player& p = *withdrawn[i];
+        std::cout << std::setw(4) << p.playerID << " | "
+            << std::setw(20) << p.getName() << " | "
+            << std::setw(10) << p.getStatusName() << " | "
+            << std::setw(10) << p.getRegTypeName() << " | "
+            << std::setw(8) << p.priority << " | "
+            << formatRegistrationTime(p.registrationTime) << "\n";
     }
-    withdrawFile.close();
 
     int selectedId = 0;
     while (true) {
@@ -459,15 +475,7 @@ void replacePlayer(PriorityQueue& pq, int /*unused*/, std::string /*unused*/, st
 
         selectedId = atoi(input.c_str());
 
-        bool found = false;
-        for (int i = 0; i < count; ++i) {
-            if (withdrawnIds[i] == selectedId) {
-                found = true;
-                break;
-            }
-        }
-
-        if (found) {
+        if (withdrawals.contains(selectedId)) {
             std::cout << "Selected player ID " << selectedId << " found.\n";
             break;
         }
@@ -476,46 +484,7 @@ void replacePlayer(PriorityQueue& pq, int /*unused*/, std::string /*unused*/, st
         }
     }
 
-    // Remove the selected player from withdrawals.txt (rewrite file excluding that player)
-    std::ifstream inFile("withdrawals.txt");
-    if (!inFile) {
-        std::cout << "Error opening withdrawals.txt for reading!\n";
-        return;
-    }
-    std::ofstream tempFile("withdrawals_temp.txt");
-    if (!tempFile) {
-        std::cout << "Error opening temporary file for writing!\n";
-        inFile.close();
-        return;
-    }
-
-    while (getline(inFile, line)) {
-        size_t pos = line.find(',');
-        if (pos != std::string::npos) {
-            int id = atoi(line.substr(0, pos).c_str());
-            if (id != selectedId) {
-                tempFile << line << "\n";
-            }
-            // else skip line to remove it
-        }
-        else {
-            tempFile << line << "\n";  // keep malformed lines
-        }
-    }
-
-    inFile.close();
-    tempFile.close();
-
-    if (remove("withdrawals.txt") != 0) {
-        std::cout << "Error deleting original withdrawals.txt file!\n";
-        return;
-    }
-    if (rename("withdrawals_temp.txt", "withdrawals.txt") != 0) {
-        std::cout << "Error renaming temporary file to withdrawals.txt!\n";
-        return;
-    }
-
-    // Continue to get replacement player info
+    // Get replacement player info
     std::string firstName, lastName, regType;
 
     while (true) {
@@ -551,47 +520,31 @@ void replacePlayer(PriorityQueue& pq, int /*unused*/, std::string /*unused*/, st
         break;
     }
 
-    std::string fullName = firstName + " " + lastName;
-    int priority = 3;
-    if (regType == "wildcard") priority = 1;
-    else if (regType == "earlybird") priority = 2;
-
-    Player newPlayer(selectedId, fullName, getCurrentDateTime(), "Registered", priority, regType);
-
-    pq.insert(newPlayer);
-
-    std::ofstream playersFile("players.txt", std::ios::app);
-    if (!playersFile) {
-        std::cout << "Error opening players.txt for writing!\n";
-    }
-    else {
-        playersFile << newPlayer.id << "," << newPlayer.name << "," << newPlayer.registrationTime << ","
-            << newPlayer.status << "," << newPlayer.regType << "," << newPlayer.priority << "\n";
-        if (playersFile.fail()) {
-            std::cout << "Error writing to players.txt!\n";
-        }
-        else {
-            std::cout << "Player " << fullName << " has been replaced the withdrawn player successfully and saved to the players list.\n";
-        }
-        playersFile.close();
+    if (completeReplacement(pq, selectedId, firstName + " " + lastName, regType)) {
         cout << "Press Enter to return to the main menu...";
         cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // discard leftover input
         cin.get(); // wait for Enter key
 
         clearScreen();
     }
-    
 }
 
-void displayPlayers(const PriorityQueue& pq) {
+// Prints the queued players in priority order
+void printPlayerQueue(const PriorityQueue& pq) {
     cout << "\nCurrent Players in Queue (Priority order):\n";
     cout << "ID | Name | Status | Type | Priority | Registered at\n";
     cout << "----------------------------------------------------\n";
-    for (int i = 0; i < pq.size; i++) {
-        const Player& p = pq.queue[i];
-        cout << p.id << " | " << p.name << " | " << p.status << " | " << p.regType << " | " << p.priority << " | " << p.registrationTime << "\n";
+    vector<const Player*> ordered;
+    pq.collectInOrder(ordered);
+    for (size_t i = 0; i < ordered.size(); i++) {
+        const Player& p = *ordered[i];
+        cout << p.playerID << " | " << p.getName() << " | " << p.getStatusName() << " | " << p.getRegTypeName() << " | " << p.priority << " | " << formatRegistrationTime(p.registrationTime) << "\n";
     }
     cout << endl;
+}
+
+void displayPlayers(const PriorityQueue& pq) {
+    printPlayerQueue(pq);
     cout << "Press Enter to return to the main menu...";
     cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // discard leftover input
     cin.get(); // wait for Enter key
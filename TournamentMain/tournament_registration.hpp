@@ -4,37 +4,89 @@
 #define TOURNAMENT_REGISTRATION_HPP
 
 #include <string>
+#include <vector>
+#include <cstdint>
+#include "player_record.hpp" // The Player record shared with match scheduling
+#include "id_index.hpp"
 
-struct Player {
-    int id;
-    std::string name;
-    std::string registrationTime;
-    std::string status;
-    int priority;
-    std::string regType;
-
-    Player();
-    Player(int, std::string, std::string, std::string, int, std::string);
-};
-
+// Registration queue: an indexed 4-ary min-heap ordered by priority (1 = wildcard first),
+// then by arrival. Players sit in stable slots and the heap moves only small
+// (key, slot) entries; a position map from player ID gives O(1) lookups and
+// O(log n) insert, removal by ID and priority change.
 class PriorityQueue {
 public:
-    Player* queue;
-    int size;
-    int capacity;
+    PriorityQueue() : nextSequence(0) {}
 
-    PriorityQueue();
-    ~PriorityQueue();
+    // Queues a player; a player whose ID is already queued is replaced (keeping their
+    // place among equal priorities if the priority did not change)
+    void insert(const Player& player);
 
-    void insert(Player);
+    // Queues many players at once: appends them all and restores the heap order with a
+    // single bottom-up heapify instead of sifting each one in. IDs already queued are
+    // replaced as by insert().
+    void insertBulk(const std::vector<Player>& batch);
+
+    // Removes and returns the player served next (lowest priority value, earliest arrival)
     Player remove();
-    bool isEmpty();
-   
-    void resize();
+
+    // Removes the player with this ID; returns false if they are not queued
+    bool removeByID(int id, Player* removed = nullptr);
+
+    // Moves a queued player to a new priority; returns false if they are not queued
+    bool changePriority(int id, int newPriority);
+
+    // The queued player with this ID, or nullptr (valid until the queue is next modified)
+    const Player* find(int id) const;
+    bool contains(int id) const { return idToSlot.contains(id); }
+
+    bool isEmpty() const { return heap.empty(); }
+    int getSize() const { return static_cast<int>(heap.size()); }
+
+    // Player at a heap position: 0 is served next, the rest are in heap (not sorted) order
+    const Player& at(int position) const { return players[heap[position].slot]; }
+
+    // Fills 'out' with every queued player in serving order
+    void collectInOrder(std::vector<const Player*>& out) const;
+
+    // Makes room for 'count' players without reallocating
+    void reserve(int count);
+
+    // Removes every player
+    void clear();
+
+private:
+    static const int ARITY = 4;
+
+    struct HeapEntry {
+        std::uint64_t key; // Priority (biased) in the high half, arrival sequence in the low half
+        int slot;          // Index into players
+    };
+
+    std::vector<Player> players;     // Stable storage, indexed by slot
+    std::vector<int> slotPosition;   // Heap position per slot (-1 for a free slot)
+    std::vector<int> freeSlots;      // Slots released by removals
+    std::vector<HeapEntry> heap;     // The d-ary heap itself
+    IdIndex idToSlot;                // playerID -> slot
+    std::uint32_t nextSequence;      // Arrival counter for FIFO order among equal priorities
+
+    static std::uint64_t makeKey(int priority, std::uint32_t sequence) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(priority) ^ 0x80000000u) << 32) | sequence;
+    }
+    void place(int position, const HeapEntry& entry) {
+        heap[position] = entry;
+        slotPosition[entry.slot] = position;
+    }
+    void siftUp(int position);
+    void siftDown(int position);
+    void removeAt(int position);
 };
 
 // Declare the functions you implement in cpp here:
 void clearScreen();
+std::string trim(const std::string& s);
+bool isAlphaString(const std::string& s);
+bool isValidRegType(const std::string& s);
+int priorityForRegType(RegistrationType type);
 void loadPlayersFromFile(PriorityQueue& pq);
 void registerPlayer(PriorityQueue& pq, int id);
 void checkInPlayer(PriorityQueue& pq, int id);
@@ -42,5 +94,13 @@ void withdrawPlayer(PriorityQueue& pq, int id);
 void replacePlayer(PriorityQueue& pq, int id, std::string, std::string);
 void displayPlayers(const PriorityQueue& pq);
 
+// Non-interactive versions of the actions above (no prompts or pauses), used by the
+// menus once their input is collected and by batch mode. Each returns false on failure.
+bool addPlayerRegistration(PriorityQueue& pq, int id, const std::string& name, const std::string& regType);
+bool completeCheckIn(PriorityQueue& pq, int id);
+bool completeWithdrawal(PriorityQueue& pq, int id);
+bool completeReplacement(PriorityQueue& pq, int id, const std::string& name, const std::string& regType);
+void printPlayerQueue(const PriorityQueue& pq);
+
 
 #endif
@@ -0,0 +1,167 @@
+#include "withdrawal_store.hpp"
+#include "output_writer.hpp" // For writeFileAtomically
+#include "perf_stats.hpp"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <cstring> // For memchr
+
+WithdrawalStore::WithdrawalStore(const char* storeFilename)
+    : filename(storeFilename), fileSize(0), endsWithNewline(true), liveRecords(0) {
+}
+
+// Calls visit(begin, end, contentEnd) for every line of 'text'; [begin, end) includes
+// the line break and [begin, contentEnd) does not
+template <typename Visitor>
+static void forEachLine(const std::string& text, Visitor visit) {
+    const char* cursor = text.data();
+    const char* end = cursor + text.size();
+    while (cursor < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+        const char* next = lineEnd ? lineEnd + 1 : end;
+        const char* contentEnd = lineEnd ? lineEnd : end;
+        if (contentEnd > cursor && contentEnd[-1] == '\r') --contentEnd;
+        visit(cursor, next, contentEnd);
+        cursor = next;
+    }
+}
+
+void WithdrawalStore::load() {
+    PERF_SCOPE("withdrawals.load");
+    records.clear();
+    idToRecord.clear();
+    liveRecords = 0;
+    fileSize = 0;
+    endsWithNewline = true;
+
+    std::string text;
+    {
+        std::ifstream file(filename.c_str(), std::ios::binary);
+        if (!file.is_open()) {
+            return; // Nothing withdrawn yet
+        }
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        text = buffer.str();
+    }
+
+    // Drop the tombstones once they make up most of the file
+    int tombstones = 0, lines = 0;
+    forEachLine(text, [&](const char* begin, const char*, const char*) {
+        lines++;
+        if (*begin == '#') tombstones++;
+    });
+    if (tombstones >= MIN_COMPACTION_TOMBSTONES && tombstones * 2 > lines) {
+        std::string compacted;
+        compacted.reserve(text.size());
+        forEachLine(text, [&](const char* begin, const char* next, const char*) {
+            if (*begin != '#') compacted.append(begin, next);
+        });
+        if (writeFileAtomically(filename.c_str(), compacted)) {
+            text.swap(compacted);
+            PERF_COUNT("withdrawals.tombstonesDropped", tombstones);
+        }
+        else {
+            std::cerr << "Warning: Could not compact " << filename << std::endl;
+        }
+    }
+
+    forEachLine(text, [&](const char* begin, const char*, const char* contentEnd) {
+        Player player;
+        if (contentEnd == begin || *begin == '#' || !parsePlayerLine(begin, contentEnd, player)) {
+            return; // Tombstones and malformed lines are left as they are
+        }
+        Record record;
+        record.player = player;
+        record.offset = static_cast<std::uint64_t>(begin - text.data());
+        record.length = static_cast<int>(contentEnd - begin);
+        record.previous = idToRecord.find(player.playerID);
+        record.live = true;
+        idToRecord.insert(player.playerID, static_cast<int>(records.size()));
+        records.push_back(record);
+        liveRecords++;
+    });
+    fileSize = text.size();
+    endsWithNewline = text.empty() || text[text.size() - 1] == '\n';
+}
+
+bool WithdrawalStore::add(const Player& player) {
+    PERF_SCOPE("withdrawals.add");
+    std::string line;
+    if (!endsWithNewline) line += '\n'; // Terminate a hand-edited last line first
+    size_t lineStart = line.size();
+    appendPlayerLine(line, player);
+
+    std::ofstream file(filename.c_str(), std::ios::binary | std::ios::app);
+    if (!file || !file.write(line.data(), static_cast<std::streamsize>(line.size())).flush()) {
+        return false;
+    }
+
+    Record record;
+    record.player = player;
+    record.offset = fileSize + lineStart;
+    record.length = static_cast<int>(line.size() - lineStart - 1);
+    record.previous = idToRecord.find(player.playerID);
+    record.live = true;
+    idToRecord.insert(player.playerID, static_cast<int>(records.size()));
+    records.push_back(record);
+    liveRecords++;
+    fileSize += line.size();
+    endsWithNewline = true;
+    return true;
+}
+
+bool WithdrawalStore::remove(int id) {
+    PERF_SCOPE("withdrawals.remove");
+    int latest = idToRecord.find(id);
+    if (latest == -1) {
+        return false;
+    }
+
+    std::fstream file(filename.c_str(), std::ios::binary | std::ios::in | std::ios::out);
+    if (!file) {
+        return false;
+    }
+    std::string tombstone;
+    for (int i = latest; i != -1; i = records[i].previous) {
+        tombstone.assign(static_cast<size_t>(records[i].length), ' ');
+        tombstone[0] = '#';
+        file.seekp(static_cast<std::streamoff>(records[i].offset));
+        file.write(tombstone.data(), static_cast<std::streamsize>(tombstone.size()));
+    }
+    if (!file.flush()) {
+        return false;
+    }
+
+    for (int i = latest; i != -1; i = records[i].previous) {
+        records[i].live = false;
+        liveRecords--;
+    }
+    idToRecord.erase(id);
+    return true;
+}
+
+const Player* WithdrawalStore::find(int id) const {
+    int index = idToRecord.find(id);
+    return index == -1 ? nullptr : &records[index].player;
+}
+
+void WithdrawalStore::collect(std::vector<const Player*>& out) const {
+    out.clear();
+    out.reserve(static_cast<size_t>(liveRecords));
+    for (size_t i = 0; i < records.size(); ++i) {
+        if (records[i].live) {
+            out.push_back(&records[i].player);
+        }
+    }
+}
+
+WithdrawalStore& withdrawalStore() {
+    static WithdrawalStore store("withdrawals.txt");
+    static bool loaded = false;
+    if (!loaded) {
+        store.load();
+        loaded = true;
+    }
+    return store;
+}
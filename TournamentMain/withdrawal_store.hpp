@@ -0,0 +1,69 @@
+#ifndef WITHDRAWAL_STORE_HPP
+#define WITHDRAWAL_STORE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "player_record.hpp"
+#include "id_index.hpp"
+
+// Withdrawn players, kept as fixed-size records in memory with a hash index from
+// player ID to the latest record, backed by withdrawals.txt in the usual line format.
+//
+// Adding a withdrawal appends one line. Removing one (when the player is replaced)
+// marks its records dead and overwrites their lines in place with a tombstone: '#'
+// followed by spaces, so the file keeps its layout and line readers skip it.
+// Tombstones are only dropped when the file is loaded and they outnumber the other
+// lines, so adding or removing a withdrawal never rewrites the file.
+class WithdrawalStore {
+public:
+    static const int MIN_COMPACTION_TOMBSTONES = 64;
+
+    explicit WithdrawalStore(const char* storeFilename);
+
+    // Reads the file (a missing file is an empty store), dropping the tombstones first
+    // if there are enough of them
+    void load();
+
+    // Records a withdrawn player; returns false if the file cannot be appended to
+    bool add(const Player& player);
+
+    // Tombstones every record of 'id'; returns false if it has none or the file cannot
+    // be written (the records stay live in that case)
+    bool remove(int id);
+
+    // The latest withdrawal of 'id', or nullptr (valid until the store is next modified)
+    const Player* find(int id) const;
+    bool contains(int id) const { return find(id) != nullptr; }
+
+    // Fills 'out' with the live records in withdrawal order
+    void collect(std::vector<const Player*>& out) const;
+
+    int getSize() const { return liveRecords; }
+    int getTombstones() const { return static_cast<int>(records.size()) - liveRecords; }
+    const char* getFilename() const { return filename.c_str(); }
+
+private:
+    struct Record {
+        Player player;
+        std::uint64_t offset; // Start of the record's line in the file
+        int length;           // Line length without the line break
+        int previous;         // Earlier record of the same ID, or -1
+        bool live;            // False once tombstoned
+    };
+
+    std::string filename;
+    std::vector<Record> records;  // In file order
+    IdIndex idToRecord;           // playerID -> latest record (live records only)
+    std::uint64_t fileSize;       // Where the next line will be appended
+    bool endsWithNewline;         // False if the last line is unterminated
+    int liveRecords;
+
+    WithdrawalStore(const WithdrawalStore&);
+    WithdrawalStore& operator=(const WithdrawalStore&);
+};
+
+// The store behind withdrawals.txt, loaded on first use
+WithdrawalStore& withdrawalStore();
+
+#endif // WITHDRAWAL_STORE_HPP
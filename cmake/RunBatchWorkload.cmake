@@ -0,0 +1,62 @@
+# Runs a batch script through the application against fresh copies of the data files,
+# so the files in the source tree are never modified. Used by the batch tests and by
+# the pgo-train target.
+#
+#   cmake -DAPP=<app> -DSCRIPT=<batch script> -DDATA_DIR=<dir with *.txt> -DWORK_DIR=<scratch dir>
+#         [-DEXPECTED_DIR=<dir>] -P RunBatchWorkload.cmake
+#
+# With EXPECTED_DIR, every file in it must match the file of the same name that the
+# run left in WORK_DIR. Line endings are ignored, and so are registration timestamps
+# (YYYY-MM-DD hh:mm:ss AM), which depend on when the test runs.
+
+foreach(required APP SCRIPT DATA_DIR WORK_DIR)
+    if(NOT DEFINED ${required})
+        message(FATAL_ERROR "RunBatchWorkload.cmake: ${required} is not set")
+    endif()
+endforeach()
+
+file(REMOVE_RECURSE "${WORK_DIR}")
+file(MAKE_DIRECTORY "${WORK_DIR}")
+file(GLOB data_files "${DATA_DIR}/*.txt")
+file(COPY ${data_files} DESTINATION "${WORK_DIR}")
+
+execute_process(
+    COMMAND "${APP}" --batch "${SCRIPT}"
+    WORKING_DIRECTORY "${WORK_DIR}"
+    RESULT_VARIABLE batch_result
+    OUTPUT_FILE "${WORK_DIR}/batch_output.log"
+    ERROR_VARIABLE batch_errors)
+
+if(NOT batch_result EQUAL 0)
+    message(FATAL_ERROR "Batch workload failed (${batch_result}):\n${batch_errors}\n"
+        "Full output: ${WORK_DIR}/batch_output.log")
+endif()
+
+if(DEFINED EXPECTED_DIR)
+    set(timestamp_pattern "[0-9][0-9][0-9][0-9]-[0-9][0-9]-[0-9][0-9] [0-9][0-9]:[0-9][0-9]:[0-9][0-9] [AP]M")
+    file(GLOB expected_files RELATIVE "${EXPECTED_DIR}" "${EXPECTED_DIR}/*")
+    if(NOT expected_files)
+        message(FATAL_ERROR "RunBatchWorkload.cmake: no expected files in ${EXPECTED_DIR}")
+    endif()
+    set(mismatches "")
+    foreach(name IN LISTS expected_files)
+        if(NOT EXISTS "${WORK_DIR}/${name}")
+            string(APPEND mismatches "  ${name}: not written by the run\n")
+            continue()
+        endif()
+        file(READ "${EXPECTED_DIR}/${name}" expected)
+        file(READ "${WORK_DIR}/${name}" actual)
+        foreach(content expected actual)
+            string(REPLACE "\r\n" "\n" ${content} "${${content}}")
+            string(REGEX REPLACE "${timestamp_pattern}" "<time>" ${content} "${${content}}")
+        endforeach()
+        if(NOT actual STREQUAL expected)
+            string(APPEND mismatches "  ${WORK_DIR}/${name} differs from ${EXPECTED_DIR}/${name}\n")
+        endif()
+    endforeach()
+    if(mismatches)
+        message(FATAL_ERROR "Batch workload output does not match the expected files:\n${mismatches}"
+            "Full output: ${WORK_DIR}/batch_output.log")
+    endif()
+endif()
+message(STATUS "Batch workload passed, output in ${WORK_DIR}/batch_output.log")